@@ -12,6 +12,7 @@ public:
     void draw(sf::RenderWindow& window);
 
     bool isFinished() const { return finished_; }
+    bool isAnimating() const { return false; } // Only input changes what is drawn
     void reset() { finished_ = false; }
 
 private:
@@ -0,0 +1,680 @@
+#include "AnimatedImage.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+/**
+ * Decodes one frame at a time onto a full-size canvas. A play-through ends
+ * when next() returns false; loop() rewinds for the next one if the file
+ * asks to be played again.
+ */
+class AnimatedImage::FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    virtual bool open(const std::string& path) = 0;
+    // Composites the next frame and copies the canvas into `rgba` (width*height*4)
+    virtual bool next(std::uint8_t* rgba, float& delay) = 0;
+    virtual bool rewind() = 0;
+
+    // Rewinds for another play-through, unless the loop count is used up or there's only one frame
+    bool loop() {
+        if (framesThisPass_ <= 1) return false;
+        if (plays_ != 0 && ++played_ >= plays_) return false;
+        return rewind();
+    }
+
+    // Back to the first frame with the loop count reset
+    bool restart() {
+        played_ = 0;
+        return rewind();
+    }
+
+    sf::Vector2u size() const { return {width_, height_}; }
+
+protected:
+    // Disposal of the previous frame's area before the next one is drawn
+    enum class Dispose { None, Clear, Restore };
+
+    struct Rect {
+        unsigned int x = 0;
+        unsigned int y = 0;
+        unsigned int width = 0;
+        unsigned int height = 0;
+    };
+
+    void resetCanvas() {
+        canvas_.assign(static_cast<std::size_t>(width_) * height_ * 4, 0);
+        dispose_ = Dispose::None;
+        framesThisPass_ = 0;
+    }
+
+    bool fitsCanvas(const Rect& rect) const {
+        return rect.width > 0 && rect.height > 0 &&
+               rect.x <= width_ && rect.width <= width_ - rect.x &&
+               rect.y <= height_ && rect.height <= height_ - rect.y;
+    }
+
+    // Applies the previous frame's disposal, and saves the canvas if this frame restores it afterwards
+    void beginFrame(const Rect& rect, Dispose dispose) {
+        if (dispose_ == Dispose::Clear) {
+            for (unsigned int row = 0; row < disposeRect_.height; ++row) {
+                std::memset(pixel(disposeRect_.x, disposeRect_.y + row), 0, static_cast<std::size_t>(disposeRect_.width) * 4);
+            }
+        } else if (dispose_ == Dispose::Restore) {
+            canvas_.swap(saved_);
+        }
+        if (dispose == Dispose::Restore) saved_ = canvas_;
+        dispose_ = dispose;
+        disposeRect_ = rect;
+    }
+
+    void endFrame(std::uint8_t* rgba) {
+        std::memcpy(rgba, canvas_.data(), canvas_.size());
+        ++framesThisPass_;
+    }
+
+    unsigned int framesDrawn() const { return framesThisPass_; }
+
+    std::uint8_t* pixel(unsigned int x, unsigned int y) {
+        return canvas_.data() + (static_cast<std::size_t>(y) * width_ + x) * 4;
+    }
+
+    unsigned int width_ = 0;
+    unsigned int height_ = 0;
+    unsigned int plays_ = 1; // 0 = forever
+    unsigned int played_ = 0;
+    std::ifstream in_;
+
+private:
+    std::vector<std::uint8_t> canvas_;
+    std::vector<std::uint8_t> saved_; // Canvas before a Restore frame
+    Dispose dispose_ = Dispose::None;
+    Rect disposeRect_;
+    unsigned int framesThisPass_ = 0;
+};
+
+namespace {
+
+using Source = AnimatedImage::FrameSource;
+
+constexpr float MIN_DELAY = 0.02f;     // Browsers treat shorter delays as "unset"
+constexpr float DEFAULT_DELAY = 0.1f;
+constexpr unsigned int MAX_EDGE = 4096;
+
+float frameDelay(float seconds) {
+    return seconds < MIN_DELAY ? DEFAULT_DELAY : seconds;
+}
+
+// --- GIF ---
+
+constexpr int LZW_MAX_CODES = 4096;
+
+// Code table: each string is a previous string plus one byte
+struct LzwTable {
+    std::uint16_t prefix[LZW_MAX_CODES];
+    std::uint8_t suffix[LZW_MAX_CODES];
+    std::uint8_t first[LZW_MAX_CODES];
+    std::uint16_t length[LZW_MAX_CODES];
+};
+
+// Decodes a GIF LZW stream into colour indices; returns how many were written
+std::size_t decodeLzw(const std::vector<std::uint8_t>& data, int minCodeSize, LzwTable& table, std::vector<std::uint8_t>& out) {
+    std::uint16_t* prefix = table.prefix;
+    std::uint8_t* suffix = table.suffix;
+    std::uint8_t* first = table.first;
+    std::uint16_t* length = table.length;
+
+    const int clearCode = 1 << minCodeSize;
+    const int endCode = clearCode + 1;
+    for (int i = 0; i < clearCode; ++i) {
+        suffix[i] = static_cast<std::uint8_t>(i);
+        first[i] = static_cast<std::uint8_t>(i);
+        length[i] = 1;
+    }
+
+    int codeSize = minCodeSize + 1;
+    int nextCode = endCode + 1;
+    int previous = -1;
+    std::uint32_t bitBuffer = 0;
+    int bitCount = 0;
+    std::size_t input = 0;
+    std::size_t written = 0;
+
+    while (written < out.size()) {
+        while (bitCount < codeSize) {
+            if (input >= data.size()) return written;
+            bitBuffer |= static_cast<std::uint32_t>(data[input++]) << bitCount;
+            bitCount += 8;
+        }
+        const int code = static_cast<int>(bitBuffer & ((1u << codeSize) - 1));
+        bitBuffer >>= codeSize;
+        bitCount -= codeSize;
+
+        if (code == clearCode) {
+            codeSize = minCodeSize + 1;
+            nextCode = endCode + 1;
+            previous = -1;
+            continue;
+        }
+        if (code == endCode) break;
+
+        if (previous >= 0) {
+            // code == nextCode is the one string not in the table yet: previous + its own first byte
+            if (code > nextCode) return written;
+            if (nextCode < LZW_MAX_CODES) {
+                prefix[nextCode] = static_cast<std::uint16_t>(previous);
+                suffix[nextCode] = first[code == nextCode ? previous : code];
+                first[nextCode] = first[previous];
+                length[nextCode] = static_cast<std::uint16_t>(length[previous] + 1);
+                ++nextCode;
+                if (nextCode == (1 << codeSize) && codeSize < 12) ++codeSize;
+            }
+        } else if (code >= clearCode) {
+            return written;
+        }
+
+        // Strings are linked back to front, so write them from their last byte
+        const std::size_t stringLength = length[code];
+        int walk = code;
+        for (std::size_t i = stringLength; i-- > 0;) {
+            if (written + i < out.size()) out[written + i] = suffix[walk];
+            walk = prefix[walk];
+        }
+        written = std::min(out.size(), written + stringLength);
+        previous = code;
+    }
+    return written;
+}
+
+class GifSource : public Source {
+public:
+    bool open(const std::string& path) override {
+        in_.open(path, std::ios::binary);
+        char signature[6];
+        std::uint8_t screen[7];
+        if (!in_.read(signature, sizeof(signature)) ||
+            (std::memcmp(signature, "GIF87a", 6) != 0 && std::memcmp(signature, "GIF89a", 6) != 0) ||
+            !in_.read(reinterpret_cast<char*>(screen), sizeof(screen))) {
+            return false;
+        }
+        width_ = screen[0] | (screen[1] << 8);
+        height_ = screen[2] | (screen[3] << 8);
+        if (width_ == 0 || height_ == 0 || width_ > MAX_EDGE || height_ > MAX_EDGE) return false;
+        if (screen[4] & 0x80 && !readPalette(globalPalette_, screen[4] & 0x07)) return false;
+
+        firstBlock_ = in_.tellg();
+        resetCanvas();
+        return true;
+    }
+
+    bool rewind() override {
+        in_.clear();
+        in_.seekg(firstBlock_);
+        resetCanvas();
+        return static_cast<bool>(in_);
+    }
+
+    bool next(std::uint8_t* rgba, float& delay) override {
+        Dispose dispose = Dispose::None;
+        int transparent = -1;
+        unsigned int delayCs = 0;
+
+        for (;;) {
+            const int block = in_.get();
+            if (block == 0x21) {
+                const int label = in_.get();
+                if (!readSubBlocks(extension_)) return false;
+                if (label == 0xF9 && extension_.size() >= 4) {
+                    // Graphic control: disposal, delay (centiseconds), transparent index
+                    const int method = (extension_[0] >> 2) & 0x07;
+                    dispose = method == 2 ? Dispose::Clear : method == 3 ? Dispose::Restore : Dispose::None;
+                    delayCs = extension_[1] | (extension_[2] << 8);
+                    transparent = (extension_[0] & 0x01) ? extension_[3] : -1;
+                } else if (label == 0xFF && extension_.size() >= 14 &&
+                           std::memcmp(extension_.data(), "NETSCAPE2.0", 11) == 0 && extension_[11] == 1) {
+                    // Loop count: the number of repeats after the first play, 0 = forever
+                    const unsigned int repeats = extension_[12] | (extension_[13] << 8);
+                    plays_ = repeats == 0 ? 0 : repeats + 1;
+                }
+            } else if (block == 0x2C) {
+                if (!readImage(rgba, dispose, transparent)) return false;
+                delay = frameDelay(static_cast<float>(delayCs) / 100.f);
+                return true;
+            } else {
+                return false; // Trailer (0x3B), end of file, or garbage
+            }
+        }
+    }
+
+private:
+    using Palette = std::vector<std::uint8_t>; // RGB triples
+
+    bool readPalette(Palette& palette, int sizeBits) {
+        palette.resize(static_cast<std::size_t>(3) << (sizeBits + 1));
+        return static_cast<bool>(in_.read(reinterpret_cast<char*>(palette.data()), static_cast<std::streamsize>(palette.size())));
+    }
+
+    bool readSubBlocks(std::vector<std::uint8_t>& data) {
+        data.clear();
+        for (;;) {
+            const int blockSize = in_.get();
+            if (blockSize < 0) return false;
+            if (blockSize == 0) return true;
+            const std::size_t offset = data.size();
+            data.resize(offset + static_cast<std::size_t>(blockSize));
+            if (!in_.read(reinterpret_cast<char*>(data.data() + offset), blockSize)) return false;
+        }
+    }
+
+    bool readImage(std::uint8_t* rgba, Dispose dispose, int transparent) {
+        std::uint8_t descriptor[9];
+        if (!in_.read(reinterpret_cast<char*>(descriptor), sizeof(descriptor))) return false;
+        Rect rect;
+        rect.x = descriptor[0] | (descriptor[1] << 8);
+        rect.y = descriptor[2] | (descriptor[3] << 8);
+        rect.width = descriptor[4] | (descriptor[5] << 8);
+        rect.height = descriptor[6] | (descriptor[7] << 8);
+        const std::uint8_t flags = descriptor[8];
+        if (flags & 0x80 && !readPalette(localPalette_, flags & 0x07)) return false;
+        const Palette& palette = (flags & 0x80) ? localPalette_ : globalPalette_;
+
+        const int minCodeSize = in_.get();
+        if (minCodeSize < 1 || minCodeSize > 11 || !readSubBlocks(lzwData_) || palette.empty()) return false;
+        // Some encoders write frames that overhang the screen; clip them rather than give up
+        rect.width = std::min(rect.width, width_ - std::min(rect.x, width_));
+        rect.height = std::min(rect.height, height_ - std::min(rect.y, height_));
+
+        // Indices are decoded at the frame's stored width even if it was clipped
+        const unsigned int storedWidth = descriptor[4] | (descriptor[5] << 8);
+        const unsigned int storedHeight = descriptor[6] | (descriptor[7] << 8);
+        // Bounded like the screen in open(), or a bad descriptor asks for gigabytes on the decode thread
+        if (storedWidth == 0 || storedHeight == 0 || storedWidth > MAX_EDGE || storedHeight > MAX_EDGE) return false;
+        indices_.resize(static_cast<std::size_t>(storedWidth) * storedHeight);
+        const std::size_t decoded = decodeLzw(lzwData_, minCodeSize, lzw_, indices_);
+
+        beginFrame(rect, fitsCanvas(rect) ? dispose : Dispose::None);
+        if (fitsCanvas(rect)) {
+            const bool interlaced = (flags & 0x40) != 0;
+            const std::size_t colours = palette.size() / 3;
+            unsigned int pass = 0;
+            unsigned int row = 0;
+            for (unsigned int line = 0; line < storedHeight; ++line) {
+                // Interlaced rows arrive as every 8th from 0, every 8th from 4, every 4th from 2, every 2nd from 1
+                const unsigned int y = interlaced ? row : line;
+                if (interlaced) {
+                    static const unsigned int START[4] = {0, 4, 2, 1};
+                    static const unsigned int STEP[4] = {8, 8, 4, 2};
+                    row += STEP[pass];
+                    while (pass < 3 && row >= storedHeight) row = START[++pass];
+                }
+                if (y >= rect.height) continue;
+                const std::size_t lineStart = static_cast<std::size_t>(line) * storedWidth;
+                std::uint8_t* out = pixel(rect.x, rect.y + y);
+                for (unsigned int x = 0; x < rect.width; ++x, out += 4) {
+                    if (lineStart + x >= decoded) break;
+                    const int index = indices_[lineStart + x];
+                    if (index == transparent || static_cast<std::size_t>(index) >= colours) continue;
+                    out[0] = palette[index * 3];
+                    out[1] = palette[index * 3 + 1];
+                    out[2] = palette[index * 3 + 2];
+                    out[3] = 255;
+                }
+            }
+        }
+        endFrame(rgba);
+        return true;
+    }
+
+    std::streampos firstBlock_;
+    Palette globalPalette_;
+    Palette localPalette_;
+    std::vector<std::uint8_t> extension_;
+    std::vector<std::uint8_t> lzwData_;
+    std::vector<std::uint8_t> indices_;
+    LzwTable lzw_;
+};
+
+// --- APNG ---
+
+const std::uint8_t PNG_SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+constexpr std::uint32_t MAX_CHUNK_BYTES = 64u << 20;
+
+std::uint32_t readBigEndian(const std::uint8_t* bytes) {
+    return (static_cast<std::uint32_t>(bytes[0]) << 24) | (static_cast<std::uint32_t>(bytes[1]) << 16) |
+           (static_cast<std::uint32_t>(bytes[2]) << 8) | bytes[3];
+}
+
+void appendBigEndian(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    out.push_back(static_cast<std::uint8_t>(value >> 24));
+    out.push_back(static_cast<std::uint8_t>(value >> 16));
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint32_t crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0) {
+    static const auto table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+void appendChunk(std::vector<std::uint8_t>& png, const char* type, const std::uint8_t* data, std::size_t size) {
+    appendBigEndian(png, static_cast<std::uint32_t>(size));
+    const std::size_t typeOffset = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data, data + size);
+    appendBigEndian(png, crc32(png.data() + typeOffset, size + 4));
+}
+
+/**
+ * Each frame's fcTL + IDAT/fdAT data is rewrapped as a standalone PNG
+ * (the file's IHDR with the frame's size, plus PLTE/tRNS) and decoded by
+ * SFML, so no inflate of our own is needed.
+ */
+class ApngSource : public Source {
+public:
+    bool open(const std::string& path) override {
+        in_.open(path, std::ios::binary);
+        std::uint8_t signature[8];
+        if (!in_.read(reinterpret_cast<char*>(signature), sizeof(signature)) ||
+            std::memcmp(signature, PNG_SIGNATURE, sizeof(signature)) != 0) {
+            return false;
+        }
+
+        bool animated = false;
+        for (;;) {
+            const std::streampos chunkStart = in_.tellg();
+            char type[4];
+            if (!readChunk(type, chunk_)) return false;
+            if (std::memcmp(type, "IHDR", 4) == 0 && chunk_.size() == 13) {
+                header_ = chunk_;
+                width_ = readBigEndian(chunk_.data());
+                height_ = readBigEndian(chunk_.data() + 4);
+            } else if (std::memcmp(type, "acTL", 4) == 0 && chunk_.size() == 8) {
+                animated = true;
+                plays_ = readBigEndian(chunk_.data() + 4);
+            } else if (std::memcmp(type, "PLTE", 4) == 0 || std::memcmp(type, "tRNS", 4) == 0) {
+                appendChunk(sharedChunks_, type, chunk_.data(), chunk_.size());
+            } else if (std::memcmp(type, "fcTL", 4) == 0 || std::memcmp(type, "IDAT", 4) == 0) {
+                firstFrame_ = chunkStart;
+                break;
+            }
+        }
+        // A plain PNG is left to SFML as a still image
+        if (!animated || header_.empty() || width_ == 0 || height_ == 0 || width_ > MAX_EDGE || height_ > MAX_EDGE) return false;
+        in_.seekg(firstFrame_);
+        resetCanvas();
+        return true;
+    }
+
+    bool rewind() override {
+        in_.clear();
+        in_.seekg(firstFrame_);
+        resetCanvas();
+        return static_cast<bool>(in_);
+    }
+
+    bool next(std::uint8_t* rgba, float& delay) override {
+        bool haveControl = false;
+        frameData_.clear();
+        std::uint8_t control[26];
+
+        for (;;) {
+            const std::streampos chunkStart = in_.tellg();
+            char type[4];
+            const bool read = readChunk(type, chunk_);
+            const bool frameEnds = !read || std::memcmp(type, "IEND", 4) == 0 ||
+                                   (std::memcmp(type, "fcTL", 4) == 0 && haveControl);
+            if (frameEnds) {
+                if (!haveControl || frameData_.empty()) return false;
+                // The chunk that ended this frame is read again by the next call
+                in_.clear();
+                in_.seekg(chunkStart);
+                return drawFrame(control, rgba, delay);
+            }
+            if (std::memcmp(type, "fcTL", 4) == 0 && chunk_.size() == 26) {
+                std::memcpy(control, chunk_.data(), sizeof(control));
+                haveControl = true;
+            } else if (std::memcmp(type, "IDAT", 4) == 0 && haveControl) {
+                // IDAT without an fcTL before it is a default image that isn't part of the animation
+                frameData_.insert(frameData_.end(), chunk_.begin(), chunk_.end());
+            } else if (std::memcmp(type, "fdAT", 4) == 0 && haveControl && chunk_.size() > 4) {
+                frameData_.insert(frameData_.end(), chunk_.begin() + 4, chunk_.end());
+            }
+        }
+    }
+
+private:
+    bool readChunk(char (&type)[4], std::vector<std::uint8_t>& data) {
+        std::uint8_t lengthBytes[4];
+        if (!in_.read(reinterpret_cast<char*>(lengthBytes), 4) || !in_.read(type, 4)) return false;
+        const std::uint32_t length = readBigEndian(lengthBytes);
+        if (length > MAX_CHUNK_BYTES) return false;
+        data.resize(length);
+        std::uint8_t crc[4];
+        return static_cast<bool>(in_.read(reinterpret_cast<char*>(data.data()), length)) &&
+               static_cast<bool>(in_.read(reinterpret_cast<char*>(crc), 4));
+    }
+
+    bool drawFrame(const std::uint8_t* control, std::uint8_t* rgba, float& delay) {
+        Rect rect;
+        rect.width = readBigEndian(control + 4);
+        rect.height = readBigEndian(control + 8);
+        rect.x = readBigEndian(control + 12);
+        rect.y = readBigEndian(control + 16);
+        const unsigned int delayNum = (control[20] << 8) | control[21];
+        const unsigned int delayDen = (control[22] << 8) | control[23];
+        const std::uint8_t disposeOp = control[24];
+        const bool blend = control[25] == 1;
+        if (!fitsCanvas(rect)) return false;
+
+        // Rewrap the frame as a PNG of its own
+        png_.assign(PNG_SIGNATURE, PNG_SIGNATURE + sizeof(PNG_SIGNATURE));
+        std::vector<std::uint8_t> header = header_;
+        header[0] = static_cast<std::uint8_t>(rect.width >> 24);
+        header[1] = static_cast<std::uint8_t>(rect.width >> 16);
+        header[2] = static_cast<std::uint8_t>(rect.width >> 8);
+        header[3] = static_cast<std::uint8_t>(rect.width);
+        header[4] = static_cast<std::uint8_t>(rect.height >> 24);
+        header[5] = static_cast<std::uint8_t>(rect.height >> 16);
+        header[6] = static_cast<std::uint8_t>(rect.height >> 8);
+        header[7] = static_cast<std::uint8_t>(rect.height);
+        appendChunk(png_, "IHDR", header.data(), header.size());
+        png_.insert(png_.end(), sharedChunks_.begin(), sharedChunks_.end());
+        appendChunk(png_, "IDAT", frameData_.data(), frameData_.size());
+        appendChunk(png_, "IEND", nullptr, 0);
+
+        sf::Image image;
+        if (!image.loadFromMemory(png_.data(), png_.size()) || image.getSize() != sf::Vector2u(rect.width, rect.height)) {
+            return false;
+        }
+
+        // The first frame has nothing to restore to, so "previous" means "clear" there
+        Dispose dispose = disposeOp == 1 ? Dispose::Clear : disposeOp == 2 ? Dispose::Restore : Dispose::None;
+        if (dispose == Dispose::Restore && framesDrawn() == 0) dispose = Dispose::Clear;
+        beginFrame(rect, dispose);
+
+        const std::uint8_t* source = image.getPixelsPtr();
+        for (unsigned int y = 0; y < rect.height; ++y) {
+            std::uint8_t* out = pixel(rect.x, rect.y + y);
+            const std::uint8_t* in = source + static_cast<std::size_t>(y) * rect.width * 4;
+            if (!blend) {
+                std::memcpy(out, in, static_cast<std::size_t>(rect.width) * 4);
+                continue;
+            }
+            for (unsigned int x = 0; x < rect.width; ++x, out += 4, in += 4) {
+                // Non-premultiplied "over"
+                const unsigned int srcAlpha = in[3];
+                if (srcAlpha == 255) {
+                    std::memcpy(out, in, 4);
+                } else if (srcAlpha != 0) {
+                    const unsigned int dstAlpha = out[3] * (255 - srcAlpha) / 255;
+                    const unsigned int outAlpha = srcAlpha + dstAlpha;
+                    for (int c = 0; c < 3; ++c) {
+                        out[c] = static_cast<std::uint8_t>((in[c] * srcAlpha + out[c] * dstAlpha) / outAlpha);
+                    }
+                    out[3] = static_cast<std::uint8_t>(outAlpha);
+                }
+            }
+        }
+        endFrame(rgba);
+
+        // Delay is a fraction of a second; a zero denominator means hundredths
+        delay = frameDelay(static_cast<float>(delayNum) / static_cast<float>(delayDen == 0 ? 100 : delayDen));
+        return true;
+    }
+
+    std::streampos firstFrame_;
+    std::vector<std::uint8_t> header_;       // IHDR payload
+    std::vector<std::uint8_t> sharedChunks_; // PLTE/tRNS, ready to copy into each frame
+    std::vector<std::uint8_t> chunk_;
+    std::vector<std::uint8_t> frameData_;
+    std::vector<std::uint8_t> png_;
+};
+
+std::unique_ptr<Source> openAnimated(const std::string& path) {
+    std::unique_ptr<Source> gif = std::make_unique<GifSource>();
+    if (gif->open(path)) return gif;
+    std::unique_ptr<Source> apng = std::make_unique<ApngSource>();
+    if (apng->open(path)) return apng;
+    return nullptr;
+}
+
+} // namespace
+
+AnimatedImage::AnimatedImage() = default;
+
+AnimatedImage::~AnimatedImage() {
+    shutdown();
+}
+
+bool AnimatedImage::open(const std::string& path) {
+    close();
+    path_ = path;
+    source_ = openAnimated(path);
+    if (!source_) {
+        // Not a GIF or APNG: one still frame
+        if (!texture_.loadFromFile(path)) {
+            std::cerr << "AnimatedImage: Failed to load " << path << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    if (!texture_.resize(source_->size())) {
+        std::cerr << "AnimatedImage: Failed to create texture for " << path << "\n";
+        source_.reset();
+        return false;
+    }
+    const std::size_t frameBytes = static_cast<std::size_t>(source_->size().x) * source_->size().y * 4;
+    for (auto& slot : slots_) slot.assign(frameBytes, 0);
+    return startPlayback();
+}
+
+void AnimatedImage::close() {
+    shutdown();
+    source_.reset();
+    animated_ = false;
+    texture_ = sf::Texture();
+    for (auto& slot : slots_) {
+        slot.clear();
+        slot.shrink_to_fit();
+    }
+}
+
+void AnimatedImage::restart() {
+    if (!source_) return;
+    shutdown();
+    if (source_->restart()) startPlayback();
+}
+
+bool AnimatedImage::startPlayback() {
+    // The first frame is decoded here, so there is something to draw before the worker gets going
+    float delay = 0.f;
+    if (!source_->next(slots_[0].data(), delay)) {
+        std::cerr << "AnimatedImage: Failed to decode " << path_ << "\n";
+        source_.reset();
+        return false;
+    }
+    texture_.update(slots_[0].data());
+
+    current_ = Frame{0, delay};
+    ready_.clear();
+    freeSlots_.clear();
+    for (std::size_t i = 1; i < RING_FRAMES; ++i) freeSlots_.push_back(i);
+    elapsed_ = 0.f;
+    stop_ = false;
+    animated_ = true;
+    thread_ = std::thread(&AnimatedImage::run, this);
+    return true;
+}
+
+void AnimatedImage::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    slotFreed_.notify_all();
+    if (thread_.joinable()) thread_.join();
+    current_.reset();
+}
+
+void AnimatedImage::run() {
+    for (;;) {
+        std::size_t slot = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            slotFreed_.wait(lock, [this] { return stop_ || !freeSlots_.empty(); });
+            if (stop_) return;
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        }
+
+        // Decoded without the lock held
+        float delay = 0.f;
+        std::uint8_t* pixels = slots_[slot].data();
+        const bool decoded = source_->next(pixels, delay) || (source_->loop() && source_->next(pixels, delay));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!decoded || stop_) {
+            freeSlots_.push_back(slot);
+            return;
+        }
+        ready_.push_back({slot, delay});
+    }
+}
+
+bool AnimatedImage::update(float dt) {
+    if (!animated_ || !current_) return false;
+    elapsed_ += dt;
+
+    std::optional<std::size_t> upload;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (elapsed_ >= current_->delay && !ready_.empty()) {
+            elapsed_ -= current_->delay;
+            freeSlots_.push_back(current_->slot);
+            current_ = ready_.front();
+            ready_.pop_front();
+            upload = current_->slot;
+        }
+        // Decoder behind, or the animation has ended: hold this frame instead of rushing to catch up later
+        elapsed_ = std::min(elapsed_, current_->delay);
+    }
+    if (!upload) return false;
+
+    slotFreed_.notify_one();
+    // The slot on screen isn't handed back to the worker until it is replaced
+    texture_.update(slots_[*upload].data());
+    return true;
+}
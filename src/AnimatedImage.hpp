@@ -0,0 +1,74 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Animated GIF / APNG player that streams its frames instead of decoding the
+ * whole file up front. A worker thread decodes and composites frames into a
+ * small ring of RGBA buffers; the render thread advances through them by
+ * each frame's delay and uploads into one reused texture. Memory is the
+ * canvas plus the ring, whatever the frame count. Any other image SFML can
+ * load plays as a single still frame.
+ */
+class AnimatedImage {
+public:
+    static constexpr std::size_t RING_FRAMES = 3; // One on screen, two decoded ahead
+
+    class FrameSource; // A GIF or APNG decoder, defined in the .cpp
+
+    AnimatedImage();
+    ~AnimatedImage();
+
+    AnimatedImage(const AnimatedImage&) = delete;
+    AnimatedImage& operator=(const AnimatedImage&) = delete;
+
+    // Decodes the first frame right away, so texture() is ready on return
+    bool open(const std::string& path);
+    void close();
+    // Back to the first frame
+    void restart();
+
+    // Advances the animation by `dt` seconds; true if the texture changed
+    bool update(float dt);
+
+    const sf::Texture& texture() const { return texture_; }
+    void setSmooth(bool smooth) { texture_.setSmooth(smooth); }
+    sf::Vector2u size() const { return texture_.getSize(); }
+    bool isOpen() const { return texture_.getSize().x > 0; }
+    bool isAnimated() const { return animated_; }
+
+private:
+    struct Frame {
+        std::size_t slot;
+        float delay; // Seconds this frame stays up
+    };
+
+    bool startPlayback();
+    void run();
+    void shutdown();
+
+    std::unique_ptr<FrameSource> source_; // Owned by the worker while it runs
+    std::string path_;
+    bool animated_ = false;
+    sf::Texture texture_;
+    float elapsed_ = 0.f; // Time the current frame has been up
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable slotFreed_;
+    std::array<std::vector<std::uint8_t>, RING_FRAMES> slots_;
+    std::vector<std::size_t> freeSlots_;
+    std::deque<Frame> ready_;      // Decoded, in display order
+    std::optional<Frame> current_; // On screen; its slot isn't reused until replaced
+    bool stop_ = false;
+};
@@ -0,0 +1,50 @@
+#include "BackdropLayer.hpp"
+#include <iostream>
+
+bool BackdropLayer::capture(const sf::RenderWindow& window, const DrawFunction& drawScene, sf::Color dim) {
+    const sf::Vector2u size = window.getSize();
+    if (!texture_ || texture_->getSize() != size) {
+        texture_.emplace();
+        if (!texture_->resize(size)) {
+            std::cerr << "BackdropLayer: failed to create " << size.x << "x" << size.y << " render texture\n";
+            texture_.reset();
+            valid_ = false;
+            return false;
+        }
+        texture_->setSmooth(false); // Drawn 1:1 with the window
+    }
+
+    texture_->setView(window.getView());
+    texture_->clear(sf::Color::Black);
+    drawScene(*texture_);
+
+    if (dim.a > 0) {
+        const sf::View& view = window.getView();
+        sf::RectangleShape shade(view.getSize());
+        shade.setPosition(view.getCenter() - view.getSize() / 2.f);
+        shade.setFillColor(dim);
+        texture_->draw(shade);
+    }
+
+    texture_->display();
+    valid_ = true;
+    return true;
+}
+
+bool BackdropLayer::isValid(const sf::RenderWindow& window) const {
+    return valid_ && texture_ && texture_->getSize() == window.getSize();
+}
+
+void BackdropLayer::release() {
+    texture_.reset();
+    valid_ = false;
+}
+
+void BackdropLayer::draw(sf::RenderWindow& window) const {
+    if (!valid_ || !texture_) return;
+
+    const sf::View view = window.getView();
+    window.setView(window.getDefaultView());
+    window.draw(sf::Sprite(texture_->getTexture()));
+    window.setView(view);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <optional>
+
+/**
+ * Frozen snapshot of the screen underneath an overlay (controller select,
+ * theme select, about). The scene is rendered once into an offscreen texture
+ * at the window's pixel size, optionally dimmed, and then drawn as a single
+ * quad every frame until the overlay closes and the layer is invalidated.
+ */
+class BackdropLayer {
+public:
+    using DrawFunction = std::function<void(sf::RenderTarget&)>;
+
+    // Renders drawScene into the snapshot using the window's current view.
+    // `dim` is blended over the result once; transparent leaves it untouched.
+    bool capture(const sf::RenderWindow& window, const DrawFunction& drawScene, sf::Color dim = sf::Color::Transparent);
+
+    // True if a snapshot exists and still matches the window size
+    bool isValid(const sf::RenderWindow& window) const;
+
+    void invalidate() { valid_ = false; }
+
+    // Frees the offscreen texture (it is recreated by the next capture)
+    void release();
+
+    // Draws the snapshot over the whole window; the window's view is left unchanged
+    void draw(sf::RenderWindow& window) const;
+
+private:
+    std::optional<sf::RenderTexture> texture_;
+    bool valid_ = false;
+};
@@ -59,22 +59,26 @@ void ControllerSelectScreen::reset() {
     finished_ = false;
     selectedIndex_ = 0;
     selectedInput_ = InputMethod::None;
+    navInput_.reset();
 }
 
 void ControllerSelectScreen::handleEvent(const sf::Event& event) {
     if (finished_) return;
 
-    // Handle keyboard input
-    if (auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-        if (keyPressed->code == sf::Keyboard::Key::Left || keyPressed->code == sf::Keyboard::Key::Up) {
+    // Arrows, D-pad and stick: one step per push
+    if (const auto action = navInput_.handleEvent(event)) {
+        if (*action == NavAction::Left || *action == NavAction::Up) {
             soundBank_.playCursor();
             selectedIndex_ = (selectedIndex_ - 1 + options_.size()) % options_.size();
-        }
-        else if (keyPressed->code == sf::Keyboard::Key::Right || keyPressed->code == sf::Keyboard::Key::Down) {
+        } else if (*action == NavAction::Right || *action == NavAction::Down) {
             soundBank_.playCursor();
             selectedIndex_ = (selectedIndex_ + 1) % options_.size();
         }
-        else if (keyPressed->code == sf::Keyboard::Key::Enter || 
+    }
+
+    // Handle keyboard input
+    if (auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        if (keyPressed->code == sf::Keyboard::Key::Enter || 
                  keyPressed->code == sf::Keyboard::Key::Space) {
             soundBank_.playSystemOk();
             selectedInput_ = options_[selectedIndex_].inputMethod;
@@ -102,26 +106,10 @@ void ControllerSelectScreen::handleEvent(const sf::Event& event) {
             finished_ = true;
         }
     }
-    
-    // Handle D-pad/stick movement
-    if (auto* joystickMoved = event.getIf<sf::Event::JoystickMoved>()) {
-        const float deadzone = 50.f;
-        
-        // Horizontal axis for selection
-        if (joystickMoved->axis == sf::Joystick::Axis::X || joystickMoved->axis == sf::Joystick::Axis::PovX) {
-            if (joystickMoved->position < -deadzone) {
-                soundBank_.playCursor();
-                selectedIndex_ = (selectedIndex_ - 1 + options_.size()) % options_.size();
-            } else if (joystickMoved->position > deadzone) {
-                soundBank_.playCursor();
-                selectedIndex_ = (selectedIndex_ + 1) % options_.size();
-            }
-        }
-    }
 }
 
 void ControllerSelectScreen::update(float dt) {
-    // Nothing to update for now
+    navInput_.update(dt); // Only clears presses whose release went elsewhere
 }
 
 void ControllerSelectScreen::draw(sf::RenderWindow& window) {
@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "InputRepeater.hpp"
 #include <string>
 #include <vector>
 
@@ -24,6 +25,7 @@ public:
     void draw(sf::RenderWindow& window);
 
     bool isFinished() const { return finished_; }
+    bool isAnimating() const { return false; } // Only input changes what is drawn
     InputMethod getSelectedInput() const { return selectedInput_; }
     void reset();
 
@@ -36,6 +38,7 @@ private:
     bool fontLoaded_ = false;
 
     UiSoundBank& soundBank_;
+    InputRepeater navInput_{InputRepeater::Config::stepsOnly()};
 
     sf::RectangleShape dimBackground_;
     sf::RectangleShape dialogBox_;
@@ -1,14 +1,36 @@
 #include "CustomThemeCreator.hpp"
+#include "PerfStats.hpp"
+#include "ThemeBundle.hpp"
+#include "ThemeRasterizer.hpp"
 #include "UiSoundBank.hpp"
 #include <iostream>
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <cmath>
 #include <algorithm>
+#include <cctype>
+#include <filesystem>
 #include <windows.h>
 
 using json = nlohmann::json;
 
+namespace {
+
+// The menu draws its background 40px larger than the window for parallax; rendering at that size keeps the dither sharp
+const sf::Vector2u BACKGROUND_SIZE{1320, 760};
+
+const std::string THEMES_DIR = "assets/Themes";
+
+// Theme name as a file name: letters, digits, '-' and '_' kept, anything else becomes '_'
+std::string bundleFileName(const std::string& name) {
+    std::string fileName;
+    for (unsigned char c : name) fileName += (std::isalnum(c) || c == '-' || c == '_') ? static_cast<char>(c) : '_';
+    if (fileName.empty()) fileName = "Custom_Theme";
+    return fileName + ThemeBundle::EXTENSION;
+}
+
+} // namespace
+
 CustomThemeCreator::CustomThemeCreator(UiSoundBank& sounds)
     : soundBank_(sounds)
     , font_()
@@ -41,6 +63,7 @@ void CustomThemeCreator::reset() {
     selectedOption_ = 0;
     finished_ = false;
     cancelled_ = false;
+    savedThemePath_.clear();
 }
 
 void CustomThemeCreator::handleEvent(const sf::Event& event) {
@@ -476,24 +499,16 @@ void CustomThemeCreator::drawFontCustomizer(sf::RenderWindow& window) {
 }
 
 void CustomThemeCreator::drawPreview(sf::RenderWindow& window) {
-    // Draw preview background
-    sf::RectangleShape previewBg({1280.f, 720.f});
-    previewBg.setFillColor(currentTheme_.colors.primary);
-    window.draw(previewBg);
-    
-    // Draw gradient if enabled
-    if (currentTheme_.gradient.enabled) {
-        // Simple vertical gradient for now
-        sf::VertexArray gradient(sf::PrimitiveType::TriangleStrip, 4);
-        gradient[0].position = {0.f, 0.f};
-        gradient[0].color = currentTheme_.gradient.startColor;
-        gradient[1].position = {1280.f, 0.f};
-        gradient[1].color = currentTheme_.gradient.startColor;
-        gradient[2].position = {0.f, 720.f};
-        gradient[2].color = currentTheme_.gradient.endColor;
-        gradient[3].position = {1280.f, 720.f};
-        gradient[3].color = currentTheme_.gradient.endColor;
-        window.draw(gradient);
+    // Background as the menu will show it: gradient and pattern, centred like the parallax sprite
+    applyThemeToPreview();
+    if (patternTexture_) {
+        sf::Sprite background(*patternTexture_);
+        background.setPosition({-20.f, -20.f});
+        window.draw(background);
+    } else {
+        sf::RectangleShape previewBg({1280.f, 720.f});
+        previewBg.setFillColor(currentTheme_.colors.primary);
+        window.draw(previewBg);
     }
     
     // Sample UI elements with theme colors
@@ -523,7 +538,31 @@ void CustomThemeCreator::drawPreview(sf::RenderWindow& window) {
 }
 
 void CustomThemeCreator::applyThemeToPreview() {
-    // Not needed with direct rendering approach
+    // Colour and slider edits that don't show in the background cost nothing here
+    if (patternTexture_ && renderedTheme_ && themeraster::sameBackground(*renderedTheme_, currentTheme_)) return;
+
+    sf::Clock timer;
+    sf::Image image = themeraster::render(currentTheme_, BACKGROUND_SIZE);
+    try {
+        // Re-uploaded in place, unless the menu still shows the previous one
+        if (patternTexture_ && patternTexture_.use_count() == 1) {
+            patternTexture_->update(image);
+        } else {
+            patternTexture_ = std::make_shared<sf::Texture>(image);
+        }
+        renderedTheme_ = currentTheme_;
+        renderedImage_ = std::move(image);
+    } catch (const std::exception& e) {
+        std::cerr << "CustomThemeCreator: failed to upload background: " << e.what() << "\n";
+        patternTexture_.reset();
+        renderedTheme_.reset();
+        renderedImage_.reset();
+        return;
+    }
+    if (perf::enabled()) {
+        std::cout << "[Perf] Rendered custom theme background in " << timer.getElapsedTime().asMicroseconds() / 1000.0
+                  << " ms (" << themeraster::kernelName() << ")\n";
+    }
 }
 
 sf::Color& CustomThemeCreator::getCurrentColorTarget() {
@@ -550,8 +589,19 @@ void CustomThemeCreator::updateColorFromSliders() {
 }
 
 void CustomThemeCreator::saveTheme() {
-    // TODO: Save theme to JSON file
-    std::cout << "Theme saved: " << currentTheme_.name << "\n";
+    // Saved with its background already rendered, so applying it later renders nothing
+    std::error_code ec;
+    std::filesystem::create_directories(THEMES_DIR, ec);
+    const std::string path = THEMES_DIR + "/" + bundleFileName(currentTheme_.name);
+    applyThemeToPreview();
+    if (!renderedImage_ || !ThemeBundle::save(path, currentTheme_, *renderedImage_)) return;
+    savedThemePath_ = path;
+    std::cout << "Theme saved: " << currentTheme_.name << " (" << path << ")\n";
+}
+
+std::shared_ptr<const sf::Texture> CustomThemeCreator::backgroundTexture() {
+    applyThemeToPreview();
+    return patternTexture_;
 }
 
 std::optional<CustomTheme> CustomThemeCreator::getCreatedTheme() const {
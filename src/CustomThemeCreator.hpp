@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 #include <optional>
@@ -72,8 +73,13 @@ public:
     void draw(sf::RenderWindow& window);
     
     bool isFinished() const { return finished_; }
+    bool isAnimating() const { return false; } // Only input changes what is drawn
     bool wasCancelled() const { return cancelled_; }
     std::optional<CustomTheme> getCreatedTheme() const;
+    // The current settings' background, rendered at the menu's parallax size; re-rendered only after a change
+    std::shared_ptr<const sf::Texture> backgroundTexture();
+    // Bundle written by the last Save & Exit; empty if nothing was saved
+    const std::string& savedThemePath() const { return savedThemePath_; }
     
     void reset();
     
@@ -136,7 +142,10 @@ private:
     // Preview rendering
     sf::RenderTexture previewTexture_;
     std::optional<sf::Texture> backgroundTexture_;
-    std::optional<sf::Texture> patternTexture_;
+    std::shared_ptr<sf::Texture> patternTexture_; // Gradient + pattern; the menu keeps a reference once applied
+    std::optional<CustomTheme> renderedTheme_;     // Settings patternTexture_ was rendered from
+    std::optional<sf::Image> renderedImage_;       // Its pixels, kept for saving
+    std::string savedThemePath_;
     
     // Pattern options
     std::vector<std::string> patternTypes_;
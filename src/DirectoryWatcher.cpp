@@ -0,0 +1,204 @@
+#include "DirectoryWatcher.hpp"
+#include <iostream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <climits>
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+DirectoryWatcher::DirectoryWatcher(std::string directory)
+    : directory_(std::move(directory)) {
+}
+
+DirectoryWatcher::~DirectoryWatcher() {
+    stop();
+}
+
+DirectoryWatcher::Changes DirectoryWatcher::takeChanges() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Changes changes;
+    changes.rescan = rescan_;
+    changes.files.assign(pending_.begin(), pending_.end());
+    pending_.clear();
+    rescan_ = false;
+    return changes;
+}
+
+void DirectoryWatcher::post(std::string name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.insert(std::move(name));
+}
+
+void DirectoryWatcher::postRescan() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rescan_ = true;
+}
+
+#ifdef _WIN32
+
+bool DirectoryWatcher::start() {
+    stop();
+    directoryHandle_ = CreateFileA(directory_.c_str(), FILE_LIST_DIRECTORY,
+                                   FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                   FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (directoryHandle_ == INVALID_HANDLE_VALUE) {
+        directoryHandle_ = nullptr;
+        std::cerr << "DirectoryWatcher: cannot open " << directory_ << "\n";
+        return false;
+    }
+    stopEvent_ = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (!stopEvent_) {
+        CloseHandle(directoryHandle_);
+        directoryHandle_ = nullptr;
+        return false;
+    }
+    watching_ = true;
+    thread_ = std::thread(&DirectoryWatcher::run, this);
+    return true;
+}
+
+void DirectoryWatcher::stop() {
+    if (thread_.joinable()) {
+        SetEvent(stopEvent_);
+        thread_.join();
+    }
+    watching_ = false;
+    for (void** handle : {&directoryHandle_, &stopEvent_}) {
+        if (*handle) CloseHandle(*handle);
+        *handle = nullptr;
+    }
+}
+
+void DirectoryWatcher::run() {
+    // DWORD-aligned, as ReadDirectoryChangesW requires; 64 KB is the most it fills over a network share
+    std::vector<DWORD> buffer(64 * 1024 / sizeof(DWORD));
+    OVERLAPPED overlapped{};
+    overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+
+    while (overlapped.hEvent) {
+        ResetEvent(overlapped.hEvent);
+        if (!ReadDirectoryChangesW(directoryHandle_, buffer.data(), static_cast<DWORD>(buffer.size() * sizeof(DWORD)),
+                                   FALSE, filter, nullptr, &overlapped, nullptr)) {
+            std::cerr << "DirectoryWatcher: lost the watch on " << directory_ << "\n";
+            break;
+        }
+
+        HANDLE waits[2] = {stopEvent_, overlapped.hEvent};
+        if (WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0 + 1) {
+            DWORD ignored = 0;
+            CancelIoEx(directoryHandle_, &overlapped);
+            GetOverlappedResult(directoryHandle_, &overlapped, &ignored, TRUE);
+            CloseHandle(overlapped.hEvent);
+            return;
+        }
+
+        DWORD bytes = 0;
+        if (!GetOverlappedResult(directoryHandle_, &overlapped, &bytes, FALSE)) break;
+        if (bytes == 0) {
+            // The buffer overflowed and the events are gone
+            postRescan();
+            continue;
+        }
+
+        const char* records = reinterpret_cast<const char*>(buffer.data());
+        for (DWORD offset = 0;;) {
+            const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(records + offset);
+            // Same code page as the FindFirstFileA listings the names are matched against
+            const int wideLength = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+            const int length = WideCharToMultiByte(CP_ACP, 0, info->FileName, wideLength, nullptr, 0, nullptr, nullptr);
+            std::string name(static_cast<std::size_t>(length), '\0');
+            WideCharToMultiByte(CP_ACP, 0, info->FileName, wideLength, name.data(), length, nullptr, nullptr);
+            post(std::move(name));
+            if (info->NextEntryOffset == 0) break;
+            offset += info->NextEntryOffset;
+        }
+    }
+
+    // The directory went away or the handle broke; callers fall back to listing it
+    if (overlapped.hEvent) CloseHandle(overlapped.hEvent);
+    watching_ = false;
+    postRescan();
+}
+
+#else
+
+bool DirectoryWatcher::start() {
+    stop();
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ < 0) {
+        std::cerr << "DirectoryWatcher: inotify unavailable\n";
+        return false;
+    }
+    const uint32_t mask = IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE |
+                          IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+    if (inotify_add_watch(inotifyFd_, directory_.c_str(), mask) < 0 || pipe(stopPipe_) != 0) {
+        std::cerr << "DirectoryWatcher: cannot watch " << directory_ << "\n";
+        stop();
+        return false;
+    }
+    watching_ = true;
+    thread_ = std::thread(&DirectoryWatcher::run, this);
+    return true;
+}
+
+void DirectoryWatcher::stop() {
+    if (thread_.joinable()) {
+        const char wake = 1;
+        if (write(stopPipe_[1], &wake, 1) < 0) {
+            std::cerr << "DirectoryWatcher: failed to signal thread\n";
+        }
+        thread_.join();
+    }
+    watching_ = false;
+    for (int* fd : {&inotifyFd_, &stopPipe_[0], &stopPipe_[1]}) {
+        if (*fd >= 0) close(*fd);
+        *fd = -1;
+    }
+}
+
+void DirectoryWatcher::run() {
+    // Room for a burst of events; each is a header plus a NUL-padded name
+    alignas(inotify_event) char buffer[16 * (sizeof(inotify_event) + NAME_MAX + 1)];
+
+    for (;;) {
+        pollfd fds[2] = {{stopPipe_[0], POLLIN, 0}, {inotifyFd_, POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[0].revents) return;
+
+        const ssize_t bytes = read(inotifyFd_, buffer, sizeof(buffer));
+        if (bytes < 0) {
+            if (errno == EAGAIN || errno == EINTR) continue;
+            break;
+        }
+
+        bool watchLost = false;
+        for (ssize_t offset = 0; offset < bytes;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            if (event->mask & IN_Q_OVERFLOW) {
+                postRescan();
+            } else if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                watchLost = true;
+            } else if (event->len > 0 && !(event->mask & IN_ISDIR)) {
+                post(event->name);
+            }
+        }
+        if (watchLost) break;
+    }
+
+    // The directory went away or inotify failed; callers fall back to listing it
+    std::cerr << "DirectoryWatcher: lost the watch on " << directory_ << "\n";
+    watching_ = false;
+    postRescan();
+}
+
+#endif
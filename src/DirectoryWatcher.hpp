@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Collects the names of files added, changed, renamed or removed in one
+ * directory (not its subdirectories), so a catalog of that folder can be
+ * patched instead of re-listed. The OS reports the changes: inotify on
+ * Linux, ReadDirectoryChangesW on Windows, each on a thread that sleeps
+ * until something happens. When the OS drops events or the watch is lost,
+ * the next takeChanges() asks for a full rescan instead.
+ */
+class DirectoryWatcher {
+public:
+    struct Changes {
+        bool rescan = false;            // Names may be missing; re-list the whole directory
+        std::vector<std::string> files; // File names inside the directory, each once, sorted
+    };
+
+    explicit DirectoryWatcher(std::string directory);
+    ~DirectoryWatcher();
+
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+    // False if the directory can't be watched; callers then re-list it every time
+    bool start();
+    void stop();
+    bool isWatching() const { return watching_.load(); }
+
+    // Everything reported since the last call
+    Changes takeChanges();
+
+private:
+    void run();
+    void post(std::string name);
+    void postRescan();
+
+    std::string directory_;
+    std::atomic<bool> watching_{false};
+    std::thread thread_;
+
+    std::mutex mutex_;
+    std::set<std::string> pending_;
+    bool rescan_ = false;
+
+#ifdef _WIN32
+    void* directoryHandle_ = nullptr;
+    void* stopEvent_ = nullptr;
+#else
+    int inotifyFd_ = -1;
+    int stopPipe_[2] = {-1, -1};
+#endif
+};
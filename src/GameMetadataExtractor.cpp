@@ -104,6 +104,12 @@ GameMetadata GameMetadataExtractor::extractFromPbp(const std::string& filePath)
     // ICON0.PNG
     meta.iconData = readSection(header.offsetIcon0, header.offsetIcon1);
 
+    // ICON1.PMF
+    meta.iconVideoData = readSection(header.offsetIcon1, header.offsetPic0);
+
+    // PIC0.PNG
+    meta.overlayData = readSection(header.offsetPic0, header.offsetPic1);
+
     // PIC1.PNG
     meta.backgroundData = readSection(header.offsetPic1, header.offsetSnd0);
 
@@ -211,6 +217,14 @@ GameMetadata GameMetadataExtractor::extractFromIso(const std::string& filePath)
                 file.seekg(entry.lba * 2048);
                 meta.iconData.resize(entry.size);
                 file.read(reinterpret_cast<char*>(meta.iconData.data()), entry.size);
+            } else if (entry.name == "ICON1.PMF") {
+                file.seekg(entry.lba * 2048);
+                meta.iconVideoData.resize(entry.size);
+                file.read(reinterpret_cast<char*>(meta.iconVideoData.data()), entry.size);
+            } else if (entry.name == "PIC0.PNG") {
+                file.seekg(entry.lba * 2048);
+                meta.overlayData.resize(entry.size);
+                file.read(reinterpret_cast<char*>(meta.overlayData.data()), entry.size);
             } else if (entry.name == "PIC1.PNG") {
                 file.seekg(entry.lba * 2048);
                 meta.backgroundData.resize(entry.size);
@@ -8,6 +8,8 @@ struct GameMetadata {
     std::string title;
     std::string gameId;
     std::vector<uint8_t> iconData;       // ICON0.PNG
+    std::vector<uint8_t> iconVideoData;  // ICON1.PMF (animated icon, see PmfDemuxer)
+    std::vector<uint8_t> overlayData;    // PIC0.PNG (info image drawn over PIC1)
     std::vector<uint8_t> backgroundData; // PIC1.PNG
     std::vector<uint8_t> soundData;      // SND0.AT3 (Raw data, might not be playable directly)
 };
@@ -4,29 +4,28 @@
 GameStartupScreen::GameStartupScreen(const std::string& imagePath, 
                                      const std::string& soundPath) {
     // Load startup image/GIF
-    try {
-        imageTex_ = sf::Texture(imagePath);
-        imageTex_.setSmooth(true); // Enable smoothing
-        imageSprite_.emplace(imageTex_);
+    if (image_.open(imagePath)) {
+        image_.setSmooth(true); // Enable smoothing
+        imageSprite_.emplace(image_.texture());
         
         // Center image on screen
-        sf::Vector2u imageSize = imageTex_.getSize();
+        sf::Vector2u imageSize = image_.size();
         imageSprite_->setOrigin({imageSize.x / 2.f, imageSize.y / 2.f});
         imageSprite_->setPosition({640.f, 360.f}); // Center of 1280x720
         
-        // Scale to fill screen
+        // Scale to fill screen; an animation has text near its edges, so it is fitted instead
         float scaleX = 1280.f / imageSize.x;
         float scaleY = 720.f / imageSize.y;
-        float scale = std::max(scaleX, scaleY); // Aspect Fill
+        float scale = image_.isAnimated() ? std::min(scaleX, scaleY) : std::max(scaleX, scaleY);
         imageSprite_->setScale({scale, scale});
 
         // Start fully transparent
         imageSprite_->setColor(sf::Color(255, 255, 255, 0));
         
-        std::cout << "GameStartupScreen: Loaded image: " << imagePath << std::endl;
-    } catch (const std::exception& e) {
-        std::cerr << "Warning: Failed to load startup image: " << imagePath 
-                  << " - " << e.what() << std::endl;
+        std::cout << "GameStartupScreen: Loaded image: " << imagePath
+                  << (image_.isAnimated() ? " (animated)" : "") << std::endl;
+    } else {
+        std::cerr << "Warning: Failed to load startup image: " << imagePath << std::endl;
     }
 
     // Load startup sound
@@ -47,6 +46,7 @@ void GameStartupScreen::start() {
         started_ = true;
         time_ = 0.f;
         finished_ = false;
+        image_.restart();
         
         // Play the startup sound
         startupSound_.play();
@@ -59,6 +59,7 @@ void GameStartupScreen::update(float dt) {
 
     // Increment time
     time_ += dt;
+    image_.update(dt);
 
     // Calculate animation phases
     float fadeInEnd = fadeInDuration_;
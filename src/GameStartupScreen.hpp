@@ -1,12 +1,13 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include "AnimatedImage.hpp"
 #include <string>
 #include <optional>
 
 /**
  * PlayStation startup screen shown before launching a game
- * - Displays animated GIF/image
+ * - Displays an animated GIF/APNG (streamed, see AnimatedImage) or a still image
  * - Plays startup sound
  * - Auto-closes when animation/sound completes
  */
@@ -19,6 +20,7 @@ public:
     void draw(sf::RenderWindow& window);
 
     bool isFinished() const { return finished_; }
+    bool isAnimating() const { return started_ && !finished_; }
     void start(); // Call this to begin the animation
 
 private:
@@ -29,7 +31,7 @@ private:
     const float holdDuration_ = 2.0f;
     const float fadeOutDuration_ = 1.0f;
 
-    sf::Texture imageTex_;
+    AnimatedImage image_;
     std::optional<sf::Sprite> imageSprite_;
 
     sf::Music startupSound_;
@@ -0,0 +1,209 @@
+#include "GimDecoder.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+constexpr char GIM_MAGIC[] = "MIG.00.1PSP";
+constexpr std::size_t FILE_HEADER_BYTES = 16;
+constexpr std::size_t BLOCK_HEADER_BYTES = 16;
+
+// Block ids; pictures hold an image and, for indexed formats, its palette
+constexpr std::uint16_t BLOCK_ROOT = 0x02;
+constexpr std::uint16_t BLOCK_PICTURE = 0x03;
+constexpr std::uint16_t BLOCK_IMAGE = 0x04;
+constexpr std::uint16_t BLOCK_PALETTE = 0x05;
+
+enum PixelFormat : std::uint16_t {
+    RGBA5650 = 0,
+    RGBA5551 = 1,
+    RGBA4444 = 2,
+    RGBA8888 = 3,
+    INDEX4 = 4,
+    INDEX8 = 5,
+    INDEX16 = 6,
+    INDEX32 = 7
+};
+
+// Bits per pixel each format must declare; anything else would read outside the plane
+constexpr unsigned int FORMAT_BPP[] = {16, 16, 16, 32, 4, 8, 16, 32};
+
+std::uint16_t readU16(const std::uint8_t* p) {
+    return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+std::uint32_t readU32(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+// The header shared by image and palette blocks
+struct Plane {
+    std::uint16_t format = 0;
+    std::uint16_t order = 0; // 1: swizzled in 16-byte x 8-row blocks
+    unsigned int width = 0;
+    unsigned int height = 0;
+    unsigned int bpp = 0;
+    unsigned int stride = 0; // Bytes per row, padded to the pitch alignment
+    unsigned int rows = 0;   // Rows stored, padded to the height alignment
+    const std::uint8_t* pixels = nullptr;
+};
+
+bool readPlane(const std::vector<std::uint8_t>& data, std::size_t offset, Plane& plane) {
+    if (offset + 0x30 > data.size()) return false;
+    const std::uint8_t* info = data.data() + offset;
+    plane.format = readU16(info + 0x04);
+    plane.order = readU16(info + 0x06);
+    plane.width = readU16(info + 0x08);
+    plane.height = readU16(info + 0x0A);
+    plane.bpp = readU16(info + 0x0C);
+    const unsigned int pitchAlign = std::max<unsigned int>(1, readU16(info + 0x0E));
+    const unsigned int heightAlign = std::max<unsigned int>(1, readU16(info + 0x10));
+    const std::uint32_t pixelsStart = readU32(info + 0x1C);
+    if (plane.width == 0 || plane.height == 0 || plane.format > INDEX32 || plane.bpp != FORMAT_BPP[plane.format]) {
+        return false;
+    }
+
+    const unsigned int rowBytes = (plane.width * plane.bpp + 7) / 8;
+    plane.stride = (rowBytes + pitchAlign - 1) / pitchAlign * pitchAlign;
+    plane.rows = (plane.height + heightAlign - 1) / heightAlign * heightAlign;
+    if (plane.order == 1 && (plane.stride % 16 != 0 || plane.rows % 8 != 0)) return false;
+
+    const std::size_t needed = static_cast<std::size_t>(plane.stride) * (plane.order == 1 ? plane.rows : plane.height);
+    if (offset + pixelsStart + needed > data.size()) return false;
+    plane.pixels = info + pixelsStart;
+    return true;
+}
+
+// Swizzled planes store 16-byte x 8-row blocks one after another; lays them back out row by row
+std::vector<std::uint8_t> unswizzle(const Plane& plane) {
+    std::vector<std::uint8_t> linear(static_cast<std::size_t>(plane.stride) * plane.rows);
+    const unsigned int blocksPerRow = plane.stride / 16;
+    const std::uint8_t* src = plane.pixels;
+    for (unsigned int blockY = 0; blockY < plane.rows / 8; ++blockY) {
+        for (unsigned int blockX = 0; blockX < blocksPerRow; ++blockX) {
+            for (unsigned int row = 0; row < 8; ++row, src += 16) {
+                std::memcpy(linear.data() + static_cast<std::size_t>(blockY * 8 + row) * plane.stride + blockX * 16, src, 16);
+            }
+        }
+    }
+    return linear;
+}
+
+std::uint8_t expand5(unsigned int v) { return static_cast<std::uint8_t>((v << 3) | (v >> 2)); }
+std::uint8_t expand6(unsigned int v) { return static_cast<std::uint8_t>((v << 2) | (v >> 4)); }
+std::uint8_t expand4(unsigned int v) { return static_cast<std::uint8_t>(v * 17); }
+
+// One direct-colour texel to RGBA; false for formats that aren't direct colour
+bool directColor(std::uint16_t format, const std::uint8_t* texel, std::uint8_t* rgba) {
+    const unsigned int v = readU16(texel);
+    switch (format) {
+    case RGBA5650:
+        rgba[0] = expand5(v & 31);
+        rgba[1] = expand6((v >> 5) & 63);
+        rgba[2] = expand5((v >> 11) & 31);
+        rgba[3] = 255;
+        return true;
+    case RGBA5551:
+        rgba[0] = expand5(v & 31);
+        rgba[1] = expand5((v >> 5) & 31);
+        rgba[2] = expand5((v >> 10) & 31);
+        rgba[3] = (v & 0x8000) ? 255 : 0;
+        return true;
+    case RGBA4444:
+        rgba[0] = expand4(v & 15);
+        rgba[1] = expand4((v >> 4) & 15);
+        rgba[2] = expand4((v >> 8) & 15);
+        rgba[3] = expand4(v >> 12);
+        return true;
+    case RGBA8888:
+        std::memcpy(rgba, texel, 4);
+        return true;
+    default:
+        return false;
+    }
+}
+
+std::uint32_t indexAt(std::uint16_t format, const std::uint8_t* row, unsigned int x) {
+    switch (format) {
+    case INDEX4: return (row[x / 2] >> ((x & 1) * 4)) & 15; // Low nibble first
+    case INDEX8: return row[x];
+    case INDEX16: return readU16(row + x * 2);
+    default: return readU32(row + x * 4);
+    }
+}
+
+} // namespace
+
+bool GimDecoder::isGim(const std::vector<std::uint8_t>& data) {
+    return data.size() >= FILE_HEADER_BYTES && std::memcmp(data.data(), GIM_MAGIC, sizeof(GIM_MAGIC) - 1) == 0;
+}
+
+std::optional<sf::Image> GimDecoder::decode(const std::vector<std::uint8_t>& data) {
+    if (!isGim(data)) return std::nullopt;
+
+    // Walk root -> picture -> image/palette; only the first picture is used
+    std::size_t imageOffset = 0;
+    std::size_t paletteOffset = 0;
+    std::size_t offset = FILE_HEADER_BYTES;
+    std::size_t end = data.size();
+    while (offset + BLOCK_HEADER_BYTES <= end && (imageOffset == 0 || paletteOffset == 0)) {
+        const std::uint8_t* block = data.data() + offset;
+        const std::uint16_t id = readU16(block);
+        const std::uint32_t size = readU32(block + 4);
+        const std::uint32_t dataOffset = readU32(block + 12);
+        if (size < BLOCK_HEADER_BYTES || dataOffset < BLOCK_HEADER_BYTES || offset + size > end) break;
+        if (id == BLOCK_ROOT || id == BLOCK_PICTURE) {
+            end = offset + size;
+            offset += dataOffset;
+            continue;
+        }
+        if (id == BLOCK_IMAGE && imageOffset == 0) imageOffset = offset + dataOffset;
+        if (id == BLOCK_PALETTE && paletteOffset == 0) paletteOffset = offset + dataOffset;
+        offset += size;
+    }
+
+    Plane image;
+    if (imageOffset == 0 || !readPlane(data, imageOffset, image)) {
+        std::cerr << "GimDecoder: no readable image block (DXT and unknown formats are not supported)\n";
+        return std::nullopt;
+    }
+    std::vector<std::uint8_t> unswizzled;
+    const std::uint8_t* pixels = image.pixels;
+    if (image.order == 1) {
+        unswizzled = unswizzle(image);
+        pixels = unswizzled.data();
+    }
+
+    std::vector<std::uint8_t> rgba(static_cast<std::size_t>(image.width) * image.height * 4);
+    if (image.format <= RGBA8888) {
+        const unsigned int texelBytes = image.bpp / 8;
+        for (unsigned int y = 0; y < image.height; ++y) {
+            const std::uint8_t* row = pixels + static_cast<std::size_t>(y) * image.stride;
+            std::uint8_t* out = rgba.data() + static_cast<std::size_t>(y) * image.width * 4;
+            for (unsigned int x = 0; x < image.width; ++x) directColor(image.format, row + x * texelBytes, out + x * 4);
+        }
+    } else {
+        // The palette is itself a one-row plane of direct colours
+        Plane palette;
+        if (paletteOffset == 0 || !readPlane(data, paletteOffset, palette) || palette.format > RGBA8888) {
+            std::cerr << "GimDecoder: indexed image without a usable palette\n";
+            return std::nullopt;
+        }
+        const unsigned int entryBytes = palette.format == RGBA8888 ? 4 : 2;
+        std::vector<std::uint8_t> colors(static_cast<std::size_t>(palette.width) * 4);
+        for (unsigned int i = 0; i < palette.width; ++i) directColor(palette.format, palette.pixels + i * entryBytes, colors.data() + i * 4);
+
+        for (unsigned int y = 0; y < image.height; ++y) {
+            const std::uint8_t* row = pixels + static_cast<std::size_t>(y) * image.stride;
+            std::uint8_t* out = rgba.data() + static_cast<std::size_t>(y) * image.width * 4;
+            for (unsigned int x = 0; x < image.width; ++x) {
+                const std::uint32_t index = indexAt(image.format, row, x);
+                if (index < palette.width) std::memcpy(out + x * 4, colors.data() + index * 4, 4);
+            }
+        }
+    }
+
+    return sf::Image({image.width, image.height}, rgba.data());
+}
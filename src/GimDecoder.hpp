@@ -0,0 +1,17 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * Decodes GIM, the PSP's native texture format, as found in theme files:
+ * the first picture's first level and frame, in any of the 16/32-bit
+ * direct colour formats or 4/8/16/32-bit indexed with a palette, swizzled
+ * ("faster" order) or linear. DXT-compressed GIMs are not supported.
+ */
+class GimDecoder {
+public:
+    static bool isGim(const std::vector<std::uint8_t>& data);
+    static std::optional<sf::Image> decode(const std::vector<std::uint8_t>& data);
+};
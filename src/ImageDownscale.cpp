@@ -0,0 +1,213 @@
+#include "ImageDownscale.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define DOWNSCALE_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define DOWNSCALE_NEON 1
+#endif
+
+namespace downscale {
+
+namespace {
+
+// Output pixels [x, outWidth) of one row: the rounded mean of each 2x2 block
+void halveRowScalar(const std::uint8_t* top, const std::uint8_t* bottom, unsigned int x, unsigned int outWidth,
+                    std::uint8_t* out) {
+    for (; x < outWidth; ++x) {
+        const std::uint8_t* a = top + x * 8;
+        const std::uint8_t* b = bottom + x * 8;
+        for (int c = 0; c < 4; ++c) {
+            out[x * 4 + c] = static_cast<std::uint8_t>((a[c] + a[c + 4] + b[c] + b[c + 4] + 2) >> 2);
+        }
+    }
+}
+
+#if defined(DOWNSCALE_SSE2)
+
+// 4 output pixels (8 source pixels from each of two rows) per iteration
+void halveRow(const std::uint8_t* top, const std::uint8_t* bottom, unsigned int outWidth, std::uint8_t* out) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi16(2);
+
+    // Sums of the 2x2 blocks for output pixels n and n+1, 16 bits per channel
+    auto blockSums = [&](__m128i upper, __m128i lower) {
+        const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(upper, zero), _mm_unpacklo_epi8(lower, zero));
+        const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(upper, zero), _mm_unpackhi_epi8(lower, zero));
+        // Each 64-bit half is one source pixel; add the pair
+        return _mm_unpacklo_epi64(_mm_add_epi16(lo, _mm_srli_si128(lo, 8)), _mm_add_epi16(hi, _mm_srli_si128(hi, 8)));
+    };
+
+    unsigned int x = 0;
+    for (; x + 4 <= outWidth; x += 4) {
+        const __m128i* a = reinterpret_cast<const __m128i*>(top + x * 8);
+        const __m128i* b = reinterpret_cast<const __m128i*>(bottom + x * 8);
+        const __m128i first = blockSums(_mm_loadu_si128(a), _mm_loadu_si128(b));
+        const __m128i second = blockSums(_mm_loadu_si128(a + 1), _mm_loadu_si128(b + 1));
+        const __m128i packed = _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(first, rounding), 2),
+                                                _mm_srli_epi16(_mm_add_epi16(second, rounding), 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), packed);
+    }
+    halveRowScalar(top, bottom, x, outWidth, out);
+}
+
+#elif defined(DOWNSCALE_NEON)
+
+// 8 output pixels per iteration; vld4 splits the channels so pairs are a pairwise add
+void halveRow(const std::uint8_t* top, const std::uint8_t* bottom, unsigned int outWidth, std::uint8_t* out) {
+    unsigned int x = 0;
+    for (; x + 8 <= outWidth; x += 8) {
+        const uint8x16x4_t a = vld4q_u8(top + x * 8);
+        const uint8x16x4_t b = vld4q_u8(bottom + x * 8);
+        uint8x8x4_t result;
+        result.val[0] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[0]), b.val[0]), 2);
+        result.val[1] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[1]), b.val[1]), 2);
+        result.val[2] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[2]), b.val[2]), 2);
+        result.val[3] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[3]), b.val[3]), 2);
+        vst4_u8(out + x * 4, result);
+    }
+    halveRowScalar(top, bottom, x, outWidth, out);
+}
+
+#else
+
+void halveRow(const std::uint8_t* top, const std::uint8_t* bottom, unsigned int outWidth, std::uint8_t* out) {
+    halveRowScalar(top, bottom, 0, outWidth, out);
+}
+
+#endif
+
+// Source span [start, end) covered by one output sample, split into per-pixel weights
+struct Span {
+    unsigned int first = 0;
+    std::vector<float> weights;
+};
+
+std::vector<Span> areaSpans(unsigned int from, unsigned int to) {
+    std::vector<Span> spans(to);
+    const double scale = static_cast<double>(from) / to;
+    for (unsigned int i = 0; i < to; ++i) {
+        const double start = i * scale;
+        const double end = std::min(static_cast<double>(from), (i + 1) * scale);
+        Span& span = spans[i];
+        span.first = static_cast<unsigned int>(start);
+        for (unsigned int p = span.first; p < from && p < end; ++p) {
+            const double covered = std::min(end, p + 1.0) - std::max(start, static_cast<double>(p));
+            span.weights.push_back(static_cast<float>(covered / (end - start)));
+        }
+    }
+    return spans;
+}
+
+// Exact area average; used for the last step, where the factor is under 2
+RgbaImage areaResize(const std::uint8_t* src, unsigned int width, unsigned int height,
+                     unsigned int outWidth, unsigned int outHeight) {
+    const std::vector<Span> columns = areaSpans(width, outWidth);
+    const std::vector<Span> rows = areaSpans(height, outHeight);
+
+    // Horizontal pass into floats, then vertical into bytes
+    std::vector<float> horizontal(static_cast<std::size_t>(outWidth) * height * 4);
+    for (unsigned int y = 0; y < height; ++y) {
+        const std::uint8_t* in = src + static_cast<std::size_t>(y) * width * 4;
+        float* out = horizontal.data() + static_cast<std::size_t>(y) * outWidth * 4;
+        for (unsigned int x = 0; x < outWidth; ++x) {
+            float sum[4] = {0.f, 0.f, 0.f, 0.f};
+            const Span& span = columns[x];
+            for (std::size_t k = 0; k < span.weights.size(); ++k) {
+                const std::uint8_t* pixel = in + (span.first + k) * 4;
+                for (int c = 0; c < 4; ++c) sum[c] += pixel[c] * span.weights[k];
+            }
+            std::memcpy(out + x * 4, sum, sizeof(sum));
+        }
+    }
+
+    RgbaImage result;
+    result.width = outWidth;
+    result.height = outHeight;
+    result.pixels.resize(static_cast<std::size_t>(outWidth) * outHeight * 4);
+    const std::size_t rowFloats = static_cast<std::size_t>(outWidth) * 4;
+    std::vector<float> sum(rowFloats);
+    for (unsigned int y = 0; y < outHeight; ++y) {
+        std::fill(sum.begin(), sum.end(), 0.f);
+        const Span& span = rows[y];
+        for (std::size_t k = 0; k < span.weights.size(); ++k) {
+            const float* in = horizontal.data() + (span.first + k) * rowFloats;
+            for (std::size_t i = 0; i < rowFloats; ++i) sum[i] += in[i] * span.weights[k];
+        }
+        std::uint8_t* out = result.pixels.data() + y * rowFloats;
+        for (std::size_t i = 0; i < rowFloats; ++i) {
+            out[i] = static_cast<std::uint8_t>(std::clamp(sum[i] + 0.5f, 0.f, 255.f));
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+void fitSize(unsigned int width, unsigned int height, unsigned int maxWidth, unsigned int maxHeight,
+             unsigned int& outWidth, unsigned int& outHeight) {
+    const double scale = std::min({1.0, static_cast<double>(maxWidth) / width, static_cast<double>(maxHeight) / height});
+    outWidth = std::max(1u, static_cast<unsigned int>(std::lround(width * scale)));
+    outHeight = std::max(1u, static_cast<unsigned int>(std::lround(height * scale)));
+}
+
+RgbaImage toFit(const std::uint8_t* pixels, unsigned int width, unsigned int height,
+                unsigned int maxWidth, unsigned int maxHeight) {
+    unsigned int targetWidth = 0;
+    unsigned int targetHeight = 0;
+    fitSize(width, height, maxWidth, maxHeight, targetWidth, targetHeight);
+
+    // Box-halve while at least 2x too big on both axes; the first step reads the source in place
+    RgbaImage current;
+    const std::uint8_t* source = pixels;
+    unsigned int sourceWidth = width;
+    unsigned int sourceHeight = height;
+    while (sourceWidth >= targetWidth * 2 && sourceHeight >= targetHeight * 2) {
+        RgbaImage half;
+        half.width = sourceWidth / 2;
+        half.height = sourceHeight / 2;
+        half.pixels.resize(static_cast<std::size_t>(half.width) * half.height * 4);
+        halve(source, sourceWidth, sourceHeight, half.pixels.data());
+        current = std::move(half);
+        source = current.pixels.data();
+        sourceWidth = current.width;
+        sourceHeight = current.height;
+    }
+
+    if (sourceWidth == targetWidth && sourceHeight == targetHeight) {
+        if (source == pixels) {
+            current.width = width;
+            current.height = height;
+            current.pixels.assign(pixels, pixels + static_cast<std::size_t>(width) * height * 4);
+        }
+        return current;
+    }
+    return areaResize(source, sourceWidth, sourceHeight, targetWidth, targetHeight);
+}
+
+void halve(const std::uint8_t* src, unsigned int width, unsigned int height, std::uint8_t* dst) {
+    const unsigned int outWidth = width / 2;
+    const unsigned int outHeight = height / 2;
+    const std::size_t stride = static_cast<std::size_t>(width) * 4;
+    for (unsigned int y = 0; y < outHeight; ++y) {
+        const std::uint8_t* top = src + static_cast<std::size_t>(y) * 2 * stride;
+        halveRow(top, top + stride, outWidth, dst + static_cast<std::size_t>(y) * outWidth * 4);
+    }
+}
+
+const char* kernelName() {
+#if defined(DOWNSCALE_SSE2)
+    return "SSE2";
+#elif defined(DOWNSCALE_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace downscale
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * RGBA downscaling for thumbnails. Whole factors of two go through a 2x2
+ * box filter (SSE2 on x86-64, NEON on ARM64, bit-identical scalar
+ * fallback); the last step, less than 2x, is an exact area average. Each
+ * halving step reads every source byte once.
+ */
+namespace downscale {
+
+struct RgbaImage {
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::vector<std::uint8_t> pixels; // width*height*4
+};
+
+// Largest size with the source's aspect ratio that fits maxWidth x maxHeight (never upscales)
+void fitSize(unsigned int width, unsigned int height, unsigned int maxWidth, unsigned int maxHeight,
+             unsigned int& outWidth, unsigned int& outHeight);
+
+// Scales `pixels` (width*height RGBA) down to fit the bound
+RgbaImage toFit(const std::uint8_t* pixels, unsigned int width, unsigned int height,
+                unsigned int maxWidth, unsigned int maxHeight);
+
+// One 2x2 box step: (width/2)x(height/2), an odd last row/column is dropped
+void halve(const std::uint8_t* src, unsigned int width, unsigned int height, std::uint8_t* dst);
+
+// Name of the kernel halve() uses, for logs
+const char* kernelName();
+
+} // namespace downscale
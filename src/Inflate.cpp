@@ -0,0 +1,306 @@
+#include "Inflate.hpp"
+#include <array>
+
+namespace inflate {
+
+namespace {
+
+constexpr int MAX_BITS = 15;
+constexpr int FAST_BITS = 9;
+constexpr int MAX_LITERAL_CODES = 288;
+constexpr int MAX_DISTANCE_CODES = 30;
+
+// LSB-first bit reader. Past the end it shifts in zeros and counts them, so a truncated
+// stream is caught by exhausted() instead of a bounds check on every bit.
+struct BitReader {
+    const std::uint8_t* data;
+    std::size_t size;
+    std::size_t pos = 0;
+    std::uint32_t buffer = 0;
+    int count = 0;
+    std::size_t padBytes = 0;
+
+    void ensure(int bits) {
+        while (count < bits) {
+            std::uint32_t byte = 0;
+            if (pos < size) {
+                byte = data[pos++];
+            } else {
+                ++padBytes;
+            }
+            buffer |= byte << count;
+            count += 8;
+        }
+    }
+
+    std::uint32_t take(int bits) {
+        if (bits == 0) return 0;
+        ensure(bits);
+        const std::uint32_t value = buffer & ((1u << bits) - 1);
+        buffer >>= bits;
+        count -= bits;
+        return value;
+    }
+
+    void alignToByte() {
+        buffer >>= (count & 7);
+        count -= (count & 7);
+    }
+
+    // Some of the zero padding has been consumed as if it were data
+    bool exhausted() const { return padBytes * 8 > static_cast<std::size_t>(count); }
+
+    // Bytes of the input the decoder has actually used (call after alignToByte)
+    std::size_t consumed() const { return pos + padBytes - static_cast<std::size_t>(count / 8); }
+};
+
+struct Huffman {
+    // (symbol << 4) | length for every code of at most FAST_BITS bits, indexed by the next
+    // FAST_BITS input bits; 0 means the code is longer and decodeSlow() has to walk it
+    std::array<std::uint16_t, 1 << FAST_BITS> fast{};
+    std::array<std::uint16_t, MAX_BITS + 1> counts{};
+    std::array<std::uint16_t, MAX_LITERAL_CODES> symbols{};
+
+    bool build(const std::uint8_t* lengths, int n) {
+        fast.fill(0);
+        counts.fill(0);
+        for (int i = 0; i < n; ++i) ++counts[lengths[i]];
+        counts[0] = 0;
+
+        // Over-subscribed sets can't be decoded; incomplete ones are legal (e.g. one distance code)
+        int left = 1;
+        for (int len = 1; len <= MAX_BITS; ++len) {
+            left = (left << 1) - counts[len];
+            if (left < 0) return false;
+        }
+
+        std::array<std::uint16_t, MAX_BITS + 2> offsets{};
+        for (int len = 1; len <= MAX_BITS; ++len) offsets[len + 1] = offsets[len] + counts[len];
+        std::array<std::uint32_t, MAX_BITS + 1> nextCode{};
+        std::uint32_t code = 0;
+        for (int len = 1; len <= MAX_BITS; ++len) {
+            code = (code + counts[len - 1]) << 1;
+            nextCode[len] = code;
+        }
+
+        for (int symbol = 0; symbol < n; ++symbol) {
+            const int len = lengths[symbol];
+            if (len == 0) continue;
+            symbols[offsets[len]++] = static_cast<std::uint16_t>(symbol);
+            if (len > FAST_BITS) {
+                ++nextCode[len];
+                continue;
+            }
+            // Codes are stored MSB-first but read LSB-first, so the table is indexed by the reversed code
+            std::uint32_t reversed = 0;
+            for (std::uint32_t c = nextCode[len]++, i = 0; i < static_cast<std::uint32_t>(len); ++i, c >>= 1) {
+                reversed = (reversed << 1) | (c & 1);
+            }
+            for (std::uint32_t k = reversed; k < fast.size(); k += 1u << len) {
+                fast[k] = static_cast<std::uint16_t>((symbol << 4) | len);
+            }
+        }
+        return true;
+    }
+
+    // Canonical decode one bit at a time (after puff.c); only reached for codes over FAST_BITS
+    int decodeSlow(BitReader& in) const {
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (int len = 1; len <= MAX_BITS; ++len) {
+            code |= static_cast<int>(in.take(1));
+            const int count = counts[len];
+            if (code - first < count) return symbols[index + (code - first)];
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+
+    int decode(BitReader& in) const {
+        in.ensure(MAX_BITS);
+        const std::uint16_t entry = fast[in.buffer & ((1u << FAST_BITS) - 1)];
+        if (entry) {
+            in.take(entry & 15);
+            return entry >> 4;
+        }
+        return decodeSlow(in);
+    }
+};
+
+constexpr std::uint16_t LENGTH_BASE[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                           31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                           2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::uint16_t DISTANCE_BASE[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                             193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                             6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+bool inflateBlock(BitReader& in, const Huffman& literals, const Huffman& distances, std::vector<std::uint8_t>& out) {
+    for (;;) {
+        const int symbol = literals.decode(in);
+        if (symbol < 0 || in.exhausted()) return false;
+        if (symbol < 256) {
+            out.push_back(static_cast<std::uint8_t>(symbol));
+            continue;
+        }
+        if (symbol == 256) return true;
+
+        const int lengthCode = symbol - 257;
+        if (lengthCode >= 29) return false;
+        const std::size_t length = LENGTH_BASE[lengthCode] + in.take(LENGTH_EXTRA[lengthCode]);
+        const int distanceCode = distances.decode(in);
+        if (distanceCode < 0 || distanceCode >= MAX_DISTANCE_CODES) return false;
+        const std::size_t distance = DISTANCE_BASE[distanceCode] + in.take(DISTANCE_EXTRA[distanceCode]);
+        if (distance > out.size()) return false;
+
+        // Byte by byte: the source may overlap what is being written (runs)
+        const std::size_t start = out.size();
+        out.resize(start + length);
+        std::uint8_t* dst = out.data() + start;
+        const std::uint8_t* src = dst - distance;
+        for (std::size_t i = 0; i < length; ++i) dst[i] = src[i];
+    }
+}
+
+const Huffman* fixedTables() {
+    static const std::array<Huffman, 2> tables = [] {
+        std::array<Huffman, 2> built;
+        std::uint8_t lengths[MAX_LITERAL_CODES];
+        for (int i = 0; i < 144; ++i) lengths[i] = 8;
+        for (int i = 144; i < 256; ++i) lengths[i] = 9;
+        for (int i = 256; i < 280; ++i) lengths[i] = 7;
+        for (int i = 280; i < MAX_LITERAL_CODES; ++i) lengths[i] = 8;
+        built[0].build(lengths, MAX_LITERAL_CODES);
+        for (int i = 0; i < MAX_DISTANCE_CODES; ++i) lengths[i] = 5;
+        built[1].build(lengths, MAX_DISTANCE_CODES);
+        return built;
+    }();
+    return tables.data();
+}
+
+bool readDynamicTables(BitReader& in, Huffman& literals, Huffman& distances) {
+    static constexpr std::uint8_t ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+    const int literalCount = static_cast<int>(in.take(5)) + 257;
+    const int distanceCount = static_cast<int>(in.take(5)) + 1;
+    const int codeLengthCount = static_cast<int>(in.take(4)) + 4;
+    if (literalCount > 286 || distanceCount > MAX_DISTANCE_CODES) return false;
+
+    std::uint8_t lengths[MAX_LITERAL_CODES + MAX_DISTANCE_CODES] = {};
+    for (int i = 0; i < codeLengthCount; ++i) lengths[ORDER[i]] = static_cast<std::uint8_t>(in.take(3));
+    Huffman codeLengths;
+    if (!codeLengths.build(lengths, 19)) return false;
+
+    // Literal and distance lengths are one run-length coded sequence
+    int index = 0;
+    while (index < literalCount + distanceCount) {
+        int symbol = codeLengths.decode(in);
+        if (symbol < 0 || in.exhausted()) return false;
+        if (symbol < 16) {
+            lengths[index++] = static_cast<std::uint8_t>(symbol);
+            continue;
+        }
+        std::uint8_t value = 0;
+        int repeat = 0;
+        if (symbol == 16) {
+            if (index == 0) return false;
+            value = lengths[index - 1];
+            repeat = 3 + static_cast<int>(in.take(2));
+        } else if (symbol == 17) {
+            repeat = 3 + static_cast<int>(in.take(3));
+        } else {
+            repeat = 11 + static_cast<int>(in.take(7));
+        }
+        if (index + repeat > literalCount + distanceCount) return false;
+        while (repeat--) lengths[index++] = value;
+    }
+
+    if (lengths[256] == 0) return false; // No end-of-block code
+    return literals.build(lengths, literalCount) && distances.build(lengths + literalCount, distanceCount);
+}
+
+bool inflateStream(BitReader& in, std::vector<std::uint8_t>& out) {
+    Huffman dynamicTables[2];
+    bool last = false;
+    while (!last) {
+        last = in.take(1) != 0;
+        const std::uint32_t type = in.take(2);
+        if (type == 0) {
+            // Stored: byte-aligned LEN, ~LEN, then the bytes as they are
+            in.alignToByte();
+            const std::uint32_t length = in.take(16);
+            if ((in.take(16) ^ 0xFFFF) != length || in.exhausted()) return false;
+            std::uint32_t remaining = length;
+            while (remaining > 0 && in.count >= 8) {
+                out.push_back(static_cast<std::uint8_t>(in.take(8)));
+                --remaining;
+            }
+            if (in.exhausted() || in.pos + remaining > in.size) return false;
+            out.insert(out.end(), in.data + in.pos, in.data + in.pos + remaining);
+            in.pos += remaining;
+        } else if (type == 1) {
+            const Huffman* fixed = fixedTables();
+            if (!inflateBlock(in, fixed[0], fixed[1], out)) return false;
+        } else if (type == 2) {
+            if (!readDynamicTables(in, dynamicTables[0], dynamicTables[1]) ||
+                !inflateBlock(in, dynamicTables[0], dynamicTables[1], out)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    in.alignToByte();
+    return !in.exhausted();
+}
+
+std::uint32_t adler32(const std::uint8_t* data, std::size_t size) {
+    std::uint32_t a = 1;
+    std::uint32_t b = 0;
+    while (size > 0) {
+        // Largest run before b can overflow 32 bits
+        const std::size_t run = size < 5552 ? size : 5552;
+        for (std::size_t i = 0; i < run; ++i) {
+            a += data[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+        data += run;
+        size -= run;
+    }
+    return (b << 16) | a;
+}
+
+} // namespace
+
+bool raw(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out, std::size_t expectedSize) {
+    out.clear();
+    out.reserve(expectedSize);
+    BitReader in{data, size};
+    return inflateStream(in, out);
+}
+
+bool zlib(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out, std::size_t expectedSize) {
+    // CMF/FLG: deflate with a window of at most 32 KB, no preset dictionary, header checksum
+    if (size < 6 || (data[0] & 0x0F) != 8 || (data[0] >> 4) > 7 || (data[1] & 0x20) ||
+        ((data[0] << 8) | data[1]) % 31 != 0) {
+        return false;
+    }
+    out.clear();
+    out.reserve(expectedSize);
+    BitReader in{data + 2, size - 2};
+    if (!inflateStream(in, out)) return false;
+
+    const std::size_t end = 2 + in.consumed();
+    if (end + 4 > size) return false;
+    const std::uint32_t expected = (static_cast<std::uint32_t>(data[end]) << 24) |
+                                   (static_cast<std::uint32_t>(data[end + 1]) << 16) |
+                                   (static_cast<std::uint32_t>(data[end + 2]) << 8) | data[end + 3];
+    return adler32(out.data(), out.size()) == expected;
+}
+
+} // namespace inflate
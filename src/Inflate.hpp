@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Deflate decoding (RFC 1951) for the compressed payloads inside PSP theme
+ * files, with the zlib wrapper (RFC 1950) those use. Huffman codes up to 9
+ * bits long resolve with one table lookup; only rare longer codes are
+ * walked bit by bit.
+ */
+namespace inflate {
+
+// Decodes a zlib stream into `out` (replacing its contents). `expectedSize`, when known, is
+// reserved up front. False on a corrupt stream or a checksum mismatch.
+bool zlib(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out, std::size_t expectedSize = 0);
+
+// Same for a bare deflate stream
+bool raw(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out, std::size_t expectedSize = 0);
+
+} // namespace inflate
@@ -0,0 +1,253 @@
+#include "InputMonitor.hpp"
+#include "WakeQueue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <mmsystem.h>
+#else
+    #include <cerrno>
+    #include <filesystem>
+    #include <fcntl.h>
+    #include <linux/input.h>
+    #include <linux/joystick.h>
+    #include <poll.h>
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+#endif
+
+InputMonitor::InputMonitor(WakeQueue& wakeQueue)
+    : wakeQueue_(wakeQueue) {
+}
+
+InputMonitor::~InputMonitor() {
+    stop();
+}
+
+void InputMonitor::trigger() {
+    wakeQueue_.post(WakeReason::Hotkey);
+}
+
+#ifdef _WIN32
+
+namespace {
+
+// Joystick ids that answered at the last scan; unplugged ids are slow to query, so they're skipped
+std::vector<UINT> connectedJoysticks() {
+    std::vector<UINT> ids;
+    const UINT count = joyGetNumDevs();
+    for (UINT id = 0; id < count && id < 16; ++id) {
+        JOYINFOEX info{};
+        info.dwSize = sizeof(info);
+        info.dwFlags = JOY_RETURNBUTTONS;
+        if (joyGetPosEx(id, &info) == JOYERR_NOERROR) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+} // namespace
+
+void InputMonitor::start(std::optional<ProcessId> emulatorPid) {
+    stop();
+    stop_ = false;
+    thread_ = std::thread(&InputMonitor::run, this, emulatorPid);
+}
+
+void InputMonitor::stop() {
+    stop_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void InputMonitor::run(std::optional<ProcessId> emulatorPid) {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<UINT> joysticks = connectedJoysticks();
+    auto nextScan = Clock::now() + std::chrono::seconds(2);
+    auto rearmAt = Clock::now();
+    int stableSamples = 0;
+    bool armed = true;
+
+    while (!stop_) {
+        const auto now = Clock::now();
+        if (now >= nextScan) {
+            joysticks = connectedJoysticks();
+            nextScan = now + std::chrono::seconds(2);
+        }
+
+        bool pressed = false;
+        if (GetAsyncKeyState(VK_ESCAPE) & 0x8000) {
+            DWORD owner = 0;
+            GetWindowThreadProcessId(GetForegroundWindow(), &owner);
+            pressed = !emulatorPid || owner == *emulatorPid;
+        }
+        for (UINT id : joysticks) {
+            if (pressed) break;
+            JOYINFOEX info{};
+            info.dwSize = sizeof(info);
+            info.dwFlags = JOY_RETURNBUTTONS;
+            pressed = joyGetPosEx(id, &info) == JOYERR_NOERROR && (info.dwButtons & (1u << HOTKEY_BUTTON));
+        }
+
+        // Fire once per press, after it has held for a couple of polls, then wait for a release
+        if (pressed) {
+            if (++stableSamples >= STABLE_SAMPLES && armed && now >= rearmAt) {
+                trigger();
+                armed = false;
+                rearmAt = now + std::chrono::milliseconds(REARM_DELAY_MS);
+            }
+        } else {
+            stableSamples = 0;
+            armed = true;
+        }
+
+        Sleep(POLL_INTERVAL_MS);
+    }
+}
+
+#else
+
+namespace {
+
+struct Device {
+    int fd;
+    bool isJoystick; // js API; otherwise an evdev keyboard
+};
+
+bool hasEscapeKey(int fd) {
+    unsigned long keys[(KEY_MAX + 1) / (8 * sizeof(unsigned long)) + 1] = {};
+    if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keys)), keys) < 0) return false;
+    constexpr std::size_t BITS = 8 * sizeof(unsigned long);
+    return (keys[KEY_ESC / BITS] >> (KEY_ESC % BITS)) & 1UL;
+}
+
+// Opens every joystick and every keyboard with an Escape key we are allowed to read
+std::vector<Device> openDevices() {
+    std::vector<Device> devices;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/dev/input", ec)) {
+        const std::string name = entry.path().filename().string();
+        const bool isJoystick = name.rfind("js", 0) == 0;
+        if (!isJoystick && name.rfind("event", 0) != 0) continue;
+
+        const int fd = open(entry.path().c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) continue;
+        if (!isJoystick && !hasEscapeKey(fd)) {
+            close(fd);
+            continue;
+        }
+        devices.push_back({fd, isJoystick});
+    }
+    return devices;
+}
+
+void closeDevices(std::vector<Device>& devices) {
+    for (const Device& device : devices) {
+        close(device.fd);
+    }
+    devices.clear();
+}
+
+// Drains a readable device; true if it delivered a fresh hotkey press. Clears fd on unplug.
+bool readPress(Device& device) {
+    bool pressed = false;
+    errno = 0;
+    if (device.isJoystick) {
+        js_event event;
+        while (read(device.fd, &event, sizeof(event)) == sizeof(event)) {
+            // Synthetic JS_EVENT_INIT events report the state at open time, not a press
+            if (event.type == JS_EVENT_BUTTON && event.number == InputMonitor::HOTKEY_BUTTON && event.value == 1) {
+                pressed = true;
+            }
+        }
+    } else {
+        input_event event;
+        while (read(device.fd, &event, sizeof(event)) == sizeof(event)) {
+            // value 2 is key autorepeat
+            if (event.type == EV_KEY && event.code == KEY_ESC && event.value == 1) {
+                pressed = true;
+            }
+        }
+    }
+    if (errno == ENODEV) {
+        close(device.fd);
+        device.fd = -1;
+    }
+    return pressed;
+}
+
+} // namespace
+
+void InputMonitor::start(std::optional<ProcessId> emulatorPid) {
+    stop();
+    if (pipe(stopPipe_) != 0) {
+        std::cerr << "InputMonitor: pipe() failed\n";
+        return;
+    }
+    stop_ = false;
+    thread_ = std::thread(&InputMonitor::run, this, emulatorPid);
+}
+
+void InputMonitor::stop() {
+    stop_ = true;
+    if (thread_.joinable()) {
+        const char wake = 1;
+        if (write(stopPipe_[1], &wake, 1) < 0) {
+            std::cerr << "InputMonitor: failed to signal thread\n";
+        }
+        thread_.join();
+    }
+    for (int& fd : stopPipe_) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+}
+
+void InputMonitor::run(std::optional<ProcessId> /*emulatorPid*/) {
+    using Clock = std::chrono::steady_clock;
+
+    // Event driven: the thread sleeps in poll() until a device or the stop pipe has data.
+    // Devices are rescanned every couple of seconds to pick up hotplugged controllers.
+    std::vector<Device> devices = openDevices();
+    auto rearmAt = Clock::now();
+
+    while (!stop_) {
+        std::vector<pollfd> fds;
+        fds.push_back({stopPipe_[0], POLLIN, 0});
+        for (const Device& device : devices) {
+            fds.push_back({device.fd, POLLIN, 0});
+        }
+
+        const int ready = poll(fds.data(), fds.size(), 2000);
+        if (stop_ || fds[0].revents) break;
+        if (ready <= 0) {
+            closeDevices(devices);
+            devices = openDevices();
+            continue;
+        }
+
+        bool pressed = false;
+        for (std::size_t i = 0; i < devices.size(); ++i) {
+            if (fds[i + 1].revents) {
+                pressed |= readPress(devices[i]);
+            }
+        }
+        devices.erase(std::remove_if(devices.begin(), devices.end(), [](const Device& d) { return d.fd < 0; }),
+                      devices.end());
+
+        const auto now = Clock::now();
+        if (pressed && now >= rearmAt) {
+            trigger();
+            rearmAt = now + std::chrono::milliseconds(REARM_DELAY_MS);
+        }
+    }
+    closeDevices(devices);
+}
+
+#endif
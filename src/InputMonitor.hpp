@@ -0,0 +1,46 @@
+#pragma once
+#include "ProcessSpawn.hpp"
+#include <atomic>
+#include <optional>
+#include <thread>
+
+class WakeQueue;
+
+/**
+ * Watches for the quick-menu hotkey (controller button 13 or Escape) while
+ * the launcher window is hidden and can't receive events. Runs on its own
+ * thread and reads the devices directly: joystick and key state polled at a
+ * low fixed rate on Windows, blocking reads of the joystick and evdev
+ * keyboard devices on Linux. A debounced press posts WakeReason::Hotkey;
+ * nothing else ever reaches the main thread.
+ */
+class InputMonitor {
+public:
+    static constexpr unsigned int HOTKEY_BUTTON = 13;   // PS5 touchpad
+    static constexpr int POLL_INTERVAL_MS = 30;          // Windows polling rate (~33 Hz)
+    static constexpr int STABLE_SAMPLES = 2;             // Press must be seen this many polls in a row
+    static constexpr int REARM_DELAY_MS = 500;           // Ignore repeats right after a trigger
+
+    explicit InputMonitor(WakeQueue& wakeQueue);
+    ~InputMonitor();
+
+    InputMonitor(const InputMonitor&) = delete;
+    InputMonitor& operator=(const InputMonitor&) = delete;
+
+    // Starts watching. If emulatorPid is known, Escape only counts while that process has focus
+    // (Windows), so typing Escape in another program doesn't pop the quick menu.
+    void start(std::optional<ProcessId> emulatorPid = std::nullopt);
+    void stop();
+    bool isRunning() const { return thread_.joinable(); }
+
+private:
+    void run(std::optional<ProcessId> emulatorPid);
+    void trigger();
+
+    WakeQueue& wakeQueue_;
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+#ifndef _WIN32
+    int stopPipe_[2] = {-1, -1};
+#endif
+};
@@ -0,0 +1,227 @@
+#include "InputRepeater.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr std::size_t MAX_STEPS_PER_UPDATE = 4; // After a long frame, don't fly past the target
+
+std::size_t indexOf(NavAction action) {
+    return static_cast<std::size_t>(action);
+}
+
+std::optional<NavAction> actionForKey(sf::Keyboard::Key key) {
+    switch (key) {
+        case sf::Keyboard::Key::Up: return NavAction::Up;
+        case sf::Keyboard::Key::Down: return NavAction::Down;
+        case sf::Keyboard::Key::Left: return NavAction::Left;
+        case sf::Keyboard::Key::Right: return NavAction::Right;
+        case sf::Keyboard::Key::PageUp: return NavAction::PageUp;
+        case sf::Keyboard::Key::PageDown: return NavAction::PageDown;
+        default: return std::nullopt;
+    }
+}
+
+std::optional<sf::Keyboard::Key> keyForAction(NavAction action) {
+    switch (action) {
+        case NavAction::Up: return sf::Keyboard::Key::Up;
+        case NavAction::Down: return sf::Keyboard::Key::Down;
+        case NavAction::Left: return sf::Keyboard::Key::Left;
+        case NavAction::Right: return sf::Keyboard::Key::Right;
+        case NavAction::PageUp: return sf::Keyboard::Key::PageUp;
+        case NavAction::PageDown: return sf::Keyboard::Key::PageDown;
+        default: return std::nullopt;
+    }
+}
+
+// L1 / R1 / L2 / R2
+std::optional<NavAction> actionForButton(unsigned int button) {
+    switch (button) {
+        case 4: return NavAction::PageUp;
+        case 5: return NavAction::PageDown;
+        case 6: return NavAction::PrevLetter;
+        case 7: return NavAction::NextLetter;
+        default: return std::nullopt;
+    }
+}
+
+std::optional<unsigned int> buttonForAction(NavAction action) {
+    switch (action) {
+        case NavAction::PageUp: return 4;
+        case NavAction::PageDown: return 5;
+        case NavAction::PrevLetter: return 6;
+        case NavAction::NextLetter: return 7;
+        default: return std::nullopt;
+    }
+}
+
+// Same convention the screens have always used: positive Y (stick or D-pad) is up
+bool isVertical(sf::Joystick::Axis axis) {
+    return axis == sf::Joystick::Axis::Y || axis == sf::Joystick::Axis::PovY;
+}
+
+bool isHorizontal(sf::Joystick::Axis axis) {
+    return axis == sf::Joystick::Axis::X || axis == sf::Joystick::Axis::PovX;
+}
+
+} // namespace
+
+InputRepeater::InputRepeater()
+    : InputRepeater(Config{}) {
+}
+
+InputRepeater::InputRepeater(const Config& config)
+    : config_(config) {
+}
+
+std::optional<NavAction> InputRepeater::handleEvent(const sf::Event& event) {
+    if (event.is<sf::Event::FocusLost>()) {
+        reset();
+        return std::nullopt;
+    }
+
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        const auto action = actionForKey(keyPressed->code);
+        if (action && press(*action, Keyboard, 0)) return action;
+    } else if (const auto* keyReleased = event.getIf<sf::Event::KeyReleased>()) {
+        if (const auto action = actionForKey(keyReleased->code)) release(*action, Keyboard);
+    } else if (const auto* buttonPressed = event.getIf<sf::Event::JoystickButtonPressed>()) {
+        const auto action = actionForButton(buttonPressed->button);
+        if (action && press(*action, Button, buttonPressed->joystickId)) return action;
+    } else if (const auto* buttonReleased = event.getIf<sf::Event::JoystickButtonReleased>()) {
+        if (const auto action = actionForButton(buttonReleased->button)) release(*action, Button);
+    } else if (const auto* moved = event.getIf<sf::Event::JoystickMoved>()) {
+        NavAction negative, positive;
+        if (isVertical(moved->axis)) {
+            negative = NavAction::Down;
+            positive = NavAction::Up;
+        } else if (isHorizontal(moved->axis)) {
+            negative = NavAction::Left;
+            positive = NavAction::Right;
+        } else {
+            return std::nullopt;
+        }
+        const bool pov = moved->axis == sf::Joystick::Axis::PovX || moved->axis == sf::Joystick::Axis::PovY;
+        const Source source = pov ? PovAxis : Axis;
+
+        // Between the two thresholds nothing changes, which absorbs stick noise at the edge
+        if (moved->position > PRESS_THRESHOLD) {
+            release(negative, source);
+            if (press(positive, source, moved->joystickId)) return positive;
+        } else if (moved->position < -PRESS_THRESHOLD) {
+            release(positive, source);
+            if (press(negative, source, moved->joystickId)) return negative;
+        } else if (std::abs(moved->position) < RELEASE_THRESHOLD) {
+            release(negative, source);
+            release(positive, source);
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<NavAction> InputRepeater::update(float dt) {
+    std::vector<NavAction> steps;
+    for (std::size_t i = 0; i < held_.size(); ++i) {
+        Held& held = held_[i];
+        const NavAction action = static_cast<NavAction>(i);
+        if (held.sources == 0) continue;
+        if (!stillActive(action, held)) {
+            held = Held{};
+            continue;
+        }
+
+        const float before = held.heldTime;
+        held.heldTime += dt;
+        if (!repeats(action) || held.heldTime < config_.initialDelay) continue;
+
+        auto rateAt = [this](float heldTime) {
+            const float ramp = config_.rampTime > 0.f
+                ? std::clamp((heldTime - config_.initialDelay) / config_.rampTime, 0.f, 1.f)
+                : 1.f;
+            return config_.startRate + (config_.maxRate - config_.startRate) * ramp;
+        };
+        if (before < config_.initialDelay) {
+            // First repeat lands exactly when the delay runs out
+            held.repeatBudget = 1.f + rateAt(held.heldTime) * (held.heldTime - config_.initialDelay);
+        } else {
+            held.repeatBudget += rateAt(held.heldTime) * dt;
+        }
+
+        std::size_t count = 0;
+        while (held.repeatBudget >= 1.f && count < MAX_STEPS_PER_UPDATE) {
+            steps.push_back(action);
+            held.repeatBudget -= 1.f;
+            ++count;
+        }
+        held.repeatBudget = std::min(held.repeatBudget, 1.f);
+    }
+    return steps;
+}
+
+bool InputRepeater::isHolding() const {
+    return std::any_of(held_.begin(), held_.end(), [](const Held& held) { return held.sources != 0; });
+}
+
+void InputRepeater::reset() {
+    held_.fill(Held{});
+}
+
+bool InputRepeater::press(NavAction action, Source source, unsigned joystickId) {
+    Held& held = held_[indexOf(action)];
+    const bool fresh = held.sources == 0;
+    held.sources |= source;
+    held.joystickId = joystickId;
+    if (fresh) {
+        held.heldTime = 0.f;
+        held.repeatBudget = 0.f;
+    }
+    return fresh;
+}
+
+void InputRepeater::release(NavAction action, Source source) {
+    held_[indexOf(action)].sources &= ~static_cast<unsigned>(source);
+}
+
+bool InputRepeater::repeats(NavAction action) const {
+    switch (action) {
+        case NavAction::Up:
+        case NavAction::Down:
+            return config_.repeatVertical;
+        case NavAction::Left:
+        case NavAction::Right:
+            return config_.repeatHorizontal;
+        default:
+            return true;
+    }
+}
+
+bool InputRepeater::stillActive(NavAction action, Held& held) const {
+    if (held.sources & Keyboard) {
+        const auto key = keyForAction(action);
+        if (!key || !sf::Keyboard::isKeyPressed(*key)) held.sources &= ~static_cast<unsigned>(Keyboard);
+    }
+
+    const unsigned id = held.joystickId;
+    if (held.sources & Button) {
+        const auto button = buttonForAction(action);
+        if (!button || !sf::Joystick::isButtonPressed(id, *button)) held.sources &= ~static_cast<unsigned>(Button);
+    }
+
+    auto axisHeld = [&](sf::Joystick::Axis vertical, sf::Joystick::Axis horizontal) {
+        if (!sf::Joystick::isConnected(id)) return false;
+        switch (action) {
+            case NavAction::Up: return sf::Joystick::getAxisPosition(id, vertical) > RELEASE_THRESHOLD;
+            case NavAction::Down: return sf::Joystick::getAxisPosition(id, vertical) < -RELEASE_THRESHOLD;
+            case NavAction::Left: return sf::Joystick::getAxisPosition(id, horizontal) < -RELEASE_THRESHOLD;
+            case NavAction::Right: return sf::Joystick::getAxisPosition(id, horizontal) > RELEASE_THRESHOLD;
+            default: return false;
+        }
+    };
+    if ((held.sources & Axis) && !axisHeld(sf::Joystick::Axis::Y, sf::Joystick::Axis::X)) {
+        held.sources &= ~static_cast<unsigned>(Axis);
+    }
+    if ((held.sources & PovAxis) && !axisHeld(sf::Joystick::Axis::PovY, sf::Joystick::Axis::PovX)) {
+        held.sources &= ~static_cast<unsigned>(PovAxis);
+    }
+    return held.sources != 0;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <SFML/Window.hpp>
+#include <array>
+#include <optional>
+#include <vector>
+
+/**
+ * Navigation actions a screen can receive from the keyboard or a controller.
+ */
+enum class NavAction {
+    Up,
+    Down,
+    Left,
+    Right,
+    PageUp,     // PageUp key / L1
+    PageDown,   // PageDown key / R1
+    PrevLetter, // L2: previous first-letter group
+    NextLetter, // R2: next first-letter group
+    Count
+};
+
+/**
+ * Shared input layer that turns keys, D-pad, stick axes and shoulder buttons
+ * into press / repeat / release of NavActions.
+ *
+ * An axis presses once when it crosses PRESS_THRESHOLD and is only released
+ * again below RELEASE_THRESHOLD, so one flick of an analog stick is one step.
+ * While an action is held it repeats after `initialDelay`, starting at
+ * `startRate` steps per second and ramping to `maxRate` over `rampTime`.
+ * OS key repeat is ignored; held keys and axes are re-checked against the live
+ * device state each update, so a release that went to another screen can't
+ * leave an action stuck.
+ */
+class InputRepeater {
+public:
+    static constexpr float PRESS_THRESHOLD = 50.f;
+    static constexpr float RELEASE_THRESHOLD = 30.f;
+
+    struct Config {
+        float initialDelay = 0.35f; // Seconds held before the first repeat
+        float startRate = 5.f;      // Steps per second right after the delay
+        float maxRate = 40.f;       // Steps per second once fully ramped
+        float rampTime = 2.f;       // Seconds to go from startRate to maxRate
+        bool repeatVertical = true;   // Page and letter jumps always repeat
+        bool repeatHorizontal = true;
+
+        // Press/release only, for short option lists where repeating just overshoots
+        static Config stepsOnly() {
+            Config config;
+            config.repeatVertical = false;
+            config.repeatHorizontal = false;
+            return config;
+        }
+    };
+
+    InputRepeater();
+    explicit InputRepeater(const Config& config);
+
+    // Feeds one window event. Returns the action if this event pressed it.
+    std::optional<NavAction> handleEvent(const sf::Event& event);
+
+    // Advances hold timers and returns the repeats that came due (usually none or one)
+    std::vector<NavAction> update(float dt);
+
+    // True while any action is held, i.e. update() may still produce repeats
+    bool isHolding() const;
+
+    // Forget everything held (screen left, window lost focus)
+    void reset();
+
+private:
+    enum Source : unsigned {
+        Keyboard = 1u << 0,
+        Axis = 1u << 1,
+        PovAxis = 1u << 2,
+        Button = 1u << 3
+    };
+
+    struct Held {
+        unsigned sources = 0;
+        unsigned joystickId = 0;
+        float heldTime = 0.f;
+        float repeatBudget = 0.f; // Fractional steps owed at the current rate
+    };
+
+    bool press(NavAction action, Source source, unsigned joystickId);
+    void release(NavAction action, Source source);
+    bool repeats(NavAction action) const;
+    bool stillActive(NavAction action, Held& held) const;
+
+    Config config_;
+    std::array<Held, static_cast<std::size_t>(NavAction::Count)> held_{};
+};
@@ -0,0 +1,248 @@
+#include "IntroCache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char CACHE_MAGIC[8] = {'P', 'S', 'P', 'I', 'N', 'T', 'R', 'O'};
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+void writeVarint(std::vector<std::uint8_t>& out, std::size_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool readVarint(const std::uint8_t*& cursor, const std::uint8_t* end, std::size_t& value) {
+    value = 0;
+    for (unsigned int shift = 0; cursor < end && shift < 64; shift += 7) {
+        const std::uint8_t byte = *cursor++;
+        value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+std::optional<IntroCache::SourceKey> IntroCache::keyFor(const std::string& sourcePath, bool withHash) {
+    std::error_code ec;
+    SourceKey key;
+    key.size = fs::file_size(sourcePath, ec);
+    if (ec) return std::nullopt;
+    key.mtime = static_cast<std::int64_t>(fs::last_write_time(sourcePath, ec).time_since_epoch().count());
+    if (ec) return std::nullopt;
+    if (!withHash) return key;
+
+    std::ifstream file(sourcePath, std::ios::binary);
+    if (!file) return std::nullopt;
+    std::uint64_t hash = 1469598103934665603ull;
+    std::vector<char> buffer(1 << 16);
+    while (file.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || file.gcount() > 0) {
+        for (std::streamsize i = 0; i < file.gcount(); ++i) {
+            hash ^= static_cast<unsigned char>(buffer[static_cast<std::size_t>(i)]);
+            hash *= 1099511628211ull;
+        }
+    }
+    key.hash = hash;
+    return key;
+}
+
+bool IntroCache::readHeader(std::istream& in, SourceKey& key, unsigned int& width, unsigned int& height,
+                            float& fps, std::uint32_t& frameCount) {
+    char magic[sizeof(CACHE_MAGIC)];
+    std::uint32_t version = 0;
+    std::uint32_t w = 0;
+    std::uint32_t h = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+        !readValue(in, version) || version != FORMAT_VERSION ||
+        !readValue(in, key.size) || !readValue(in, key.mtime) || !readValue(in, key.hash) ||
+        !readValue(in, w) || !readValue(in, h) || !readValue(in, fps) || !readValue(in, frameCount)) {
+        return false;
+    }
+    if (w == 0 || h == 0 || w % 2 || h % 2 || w > 8192 || h > 8192 || !(fps > 0.f)) return false;
+    width = w;
+    height = h;
+    return true;
+}
+
+bool IntroCache::isValid(const std::string& cachePath, const std::string& sourcePath) {
+    std::ifstream in(cachePath, std::ios::binary);
+    if (!in) return false;
+
+    SourceKey cached;
+    unsigned int width = 0;
+    unsigned int height = 0;
+    float fps = 0.f;
+    std::uint32_t frameCount = 0;
+    if (!readHeader(in, cached, width, height, fps, frameCount) || frameCount == 0) return false;
+
+    const auto current = keyFor(sourcePath, false);
+    if (!current || current->size != cached.size) return false;
+    if (current->mtime == cached.mtime) return true;
+
+    // Touched but maybe not changed (copied, restored from a backup): the content decides
+    const auto hashed = keyFor(sourcePath, true);
+    if (!hashed || hashed->hash != cached.hash) return false;
+
+    // Same content: store the new mtime so later boots take the cheap check instead of hashing again
+    in.close();
+    std::fstream header(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+    header.seekp(sizeof(CACHE_MAGIC) + sizeof(std::uint32_t) + sizeof(std::uint64_t));
+    writeValue(header, hashed->mtime);
+    if (!header) std::cerr << "IntroCache: cannot update " << cachePath << "\n";
+    return true;
+}
+
+bool IntroCache::open(const std::string& cachePath) {
+    in_.close();
+    in_.clear();
+    in_.open(cachePath, std::ios::binary);
+    if (!in_) return false;
+
+    SourceKey key;
+    if (!readHeader(in_, key, width_, height_, fps_, frameCount_)) {
+        std::cerr << "IntroCache: " << cachePath << " is not a valid intro cache\n";
+        in_.close();
+        return false;
+    }
+    previous_.assign(frameBytes(), 0);
+    framesRead_ = 0;
+    return true;
+}
+
+bool IntroCache::readFrame(std::uint8_t* yuv) {
+    if (!in_.is_open() || framesRead_ >= frameCount_) return false;
+
+    std::uint32_t payloadBytes = 0;
+    if (!readValue(in_, payloadBytes) || payloadBytes > frameBytes() * 2 + 64) return false;
+    payload_.resize(payloadBytes);
+    if (!in_.read(reinterpret_cast<char*>(payload_.data()), payloadBytes)) return false;
+
+    // Skip/copy pairs against the previous frame, which previous_ still holds
+    const std::uint8_t* cursor = payload_.data();
+    const std::uint8_t* end = cursor + payload_.size();
+    std::size_t position = 0;
+    while (cursor < end) {
+        std::size_t skip = 0;
+        std::size_t copy = 0;
+        if (!readVarint(cursor, end, skip) || !readVarint(cursor, end, copy) ||
+            position + skip + copy > previous_.size() || static_cast<std::size_t>(end - cursor) < copy) {
+            std::cerr << "IntroCache: corrupt frame " << framesRead_ << "\n";
+            return false;
+        }
+        position += skip;
+        std::memcpy(previous_.data() + position, cursor, copy);
+        position += copy;
+        cursor += copy;
+    }
+
+    std::memcpy(yuv, previous_.data(), previous_.size());
+    ++framesRead_;
+    return true;
+}
+
+bool IntroCache::beginRecording(const std::string& cachePath, const SourceKey& key,
+                                unsigned int width, unsigned int height, float fps) {
+    abortRecording();
+    recordPath_ = cachePath;
+    out_.open(cachePath + ".tmp", std::ios::binary | std::ios::trunc);
+    if (!out_) {
+        std::cerr << "IntroCache: cannot write " << cachePath << ".tmp\n";
+        return false;
+    }
+
+    width_ = width;
+    height_ = height;
+    fps_ = fps;
+    frameCount_ = 0;
+    previous_.assign(frameBytes(), 0);
+
+    out_.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    writeValue(out_, FORMAT_VERSION);
+    writeValue(out_, key.size);
+    writeValue(out_, key.mtime);
+    writeValue(out_, key.hash);
+    writeValue(out_, static_cast<std::uint32_t>(width));
+    writeValue(out_, static_cast<std::uint32_t>(height));
+    writeValue(out_, fps);
+    writeValue(out_, frameCount_); // Patched by finishRecording()
+    return static_cast<bool>(out_);
+}
+
+bool IntroCache::addFrame(const std::uint8_t* yuv) {
+    if (!out_.is_open()) return false;
+
+    payload_.clear();
+    const std::size_t size = previous_.size();
+    std::size_t position = 0;
+    while (position < size) {
+        // Unchanged run, then the changed bytes up to the next unchanged run worth skipping
+        std::size_t skip = 0;
+        while (position + skip < size && yuv[position + skip] == previous_[position + skip]) ++skip;
+        if (position + skip == size) break;
+
+        const std::size_t copyStart = position + skip;
+        std::size_t copyEnd = copyStart;
+        std::size_t same = 0;
+        while (copyEnd < size && same < MIN_SKIP) {
+            same = yuv[copyEnd] == previous_[copyEnd] ? same + 1 : 0;
+            ++copyEnd;
+        }
+        if (same >= MIN_SKIP) copyEnd -= same;
+
+        writeVarint(payload_, skip);
+        writeVarint(payload_, copyEnd - copyStart);
+        payload_.insert(payload_.end(), yuv + copyStart, yuv + copyEnd);
+        position = copyEnd;
+    }
+
+    writeValue(out_, static_cast<std::uint32_t>(payload_.size()));
+    out_.write(reinterpret_cast<const char*>(payload_.data()), static_cast<std::streamsize>(payload_.size()));
+    std::memcpy(previous_.data(), yuv, size);
+    ++frameCount_;
+    return static_cast<bool>(out_);
+}
+
+bool IntroCache::finishRecording() {
+    if (!out_.is_open()) return false;
+    const std::streamoff frameCountOffset = sizeof(CACHE_MAGIC) + sizeof(std::uint32_t) + sizeof(std::uint64_t) +
+                                            sizeof(std::int64_t) + sizeof(std::uint64_t) + 2 * sizeof(std::uint32_t) +
+                                            sizeof(float);
+    out_.seekp(frameCountOffset);
+    writeValue(out_, frameCount_);
+    const bool ok = static_cast<bool>(out_) && frameCount_ > 0;
+    out_.close();
+
+    std::error_code ec;
+    if (ok) fs::rename(recordPath_ + ".tmp", recordPath_, ec);
+    if (!ok || ec) {
+        std::cerr << "IntroCache: failed to save " << recordPath_ << "\n";
+        fs::remove(recordPath_ + ".tmp", ec);
+        return false;
+    }
+    std::cout << "IntroCache: saved " << frameCount_ << " frames to " << recordPath_ << "\n";
+    return true;
+}
+
+void IntroCache::abortRecording() {
+    if (!out_.is_open()) return;
+    out_.close();
+    std::error_code ec;
+    fs::remove(recordPath_ + ".tmp", ec);
+}
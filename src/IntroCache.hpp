@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Decoded intro video kept on disk so later boots play it without ffmpeg.
+ *
+ * Frames are stored as yuv420p, each as the byte runs that changed since
+ * the previous frame (skip/copy pairs), which is small for a mostly static
+ * logo animation and decodes as a handful of memcpys. The file records the
+ * source video's size, mtime and content hash; it is written to a .tmp and
+ * only renamed into place once the whole stream has been recorded.
+ */
+class IntroCache {
+public:
+    struct SourceKey {
+        std::uint64_t size = 0;
+        std::int64_t mtime = 0;
+        std::uint64_t hash = 0; // FNV-1a of the whole file
+    };
+
+    // Size and mtime always; the hash too when `withHash` (it reads the file)
+    static std::optional<SourceKey> keyFor(const std::string& sourcePath, bool withHash);
+
+    // True if `cachePath` was recorded from this exact source
+    static bool isValid(const std::string& cachePath, const std::string& sourcePath);
+
+    // Playback
+    bool open(const std::string& cachePath);
+    bool readFrame(std::uint8_t* yuv); // False at the end of the stream
+    unsigned int width() const { return width_; }
+    unsigned int height() const { return height_; }
+    float fps() const { return fps_; }
+    std::uint32_t frameCount() const { return frameCount_; }
+
+    // Recording
+    bool beginRecording(const std::string& cachePath, const SourceKey& key,
+                        unsigned int width, unsigned int height, float fps);
+    bool addFrame(const std::uint8_t* yuv);
+    bool finishRecording();
+    void abortRecording();
+    bool isRecording() const { return out_.is_open(); }
+
+private:
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+    static constexpr std::size_t MIN_SKIP = 16; // Shorter unchanged runs are cheaper to copy
+
+    static bool readHeader(std::istream& in, SourceKey& key, unsigned int& width, unsigned int& height,
+                           float& fps, std::uint32_t& frameCount);
+
+    std::size_t frameBytes() const { return static_cast<std::size_t>(width_) * height_ * 3 / 2; }
+
+    unsigned int width_ = 0;
+    unsigned int height_ = 0;
+    float fps_ = 0.f;
+    std::uint32_t frameCount_ = 0;
+    std::vector<std::uint8_t> previous_; // Last frame read or written
+    std::vector<std::uint8_t> payload_;
+
+    std::ifstream in_;
+    std::uint32_t framesRead_ = 0;
+
+    std::ofstream out_;
+    std::string recordPath_;
+};
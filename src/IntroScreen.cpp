@@ -1,18 +1,12 @@
 #include "IntroScreen.hpp"
 #include "UiSoundBank.hpp"
+#include "YuvConvert.hpp"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
 #include <filesystem>
-
-// Windows specific for _popen
-#ifdef _WIN32
-    #define POPEN _popen
-    #define PCLOSE _pclose
-#else
-    #define POPEN popen
-    #define PCLOSE pclose
-#endif
+#include <fstream>
+#include <nlohmann/json.hpp>
 
 IntroScreen::IntroScreen(UiSoundBank& sounds,
                          const std::string& logoPath)
@@ -68,49 +62,76 @@ bool IntroScreen::tryStartVideo() {
         return false;
     }
 
-    // 1. Extract Audio if needed (or always to be safe)
+    // After the first full play the decoded frames and the extracted audio are reused; ffmpeg only
+    // runs again when the video file changes
+    const std::string cachePath = videoPath + ".cache";
+    const bool cached = std::filesystem::exists(audioPath) && IntroCache::isValid(cachePath, videoPath);
+
+    // 1. Extract Audio if needed
     // We use ffmpeg to extract audio to a temp wav file
     // -y overwrites, -vn no video, -acodec pcm_s16le (wav standard)
-    std::string audioCmd = "ffmpeg -i \"" + videoPath + "\" -vn -acodec pcm_s16le -ar 44100 -ac 2 \"" + audioPath + "\" -y -loglevel quiet";
-    system(audioCmd.c_str());
-
-    // 2. Load Audio
-    if (videoAudio_.openFromFile(audioPath)) {
-        videoAudio_.play();
-    } else {
-        std::cerr << "IntroScreen: Failed to load extracted audio.\n";
+    if (!cached) {
+        std::string audioCmd = "ffmpeg -i \"" + videoPath + "\" -vn -acodec pcm_s16le -ar 44100 -ac 2 \"" + audioPath + "\" -y -loglevel quiet";
+        system(audioCmd.c_str());
     }
 
-    // 3. Open Video Pipe
-    // -vf scale=1280:720,fps=30: Native 720p at 30fps
-    // -f image2pipe -vcodec rawvideo -pix_fmt rgba outputs raw pixels
-    std::string cmd = "ffmpeg -i \"" + videoPath + "\" -vf scale=1280:720,fps=30 -f image2pipe -vcodec rawvideo -pix_fmt rgba -loglevel quiet -";
-    ffmpegPipe_ = POPEN(cmd.c_str(), "rb");
-
-    if (!ffmpegPipe_) {
-        std::cerr << "IntroScreen: Failed to open ffmpeg pipe.\n";
-        return false;
+    // 2. Load Audio (played once the first frame is decoded, so the two start together)
+    if (!videoAudio_.openFromFile(audioPath)) {
+        std::cerr << "IntroScreen: Failed to load extracted audio.\n";
     }
 
     // Prepare texture (1280x720)
-    if (!videoTexture_.resize({1280, 720})) {
+    if (!videoTexture_.resize({VIDEO_WIDTH, VIDEO_HEIGHT})) {
          std::cerr << "IntroScreen: Failed to create video texture.\n";
          return false;
     }
     videoTexture_.setSmooth(false);
     videoSprite_.emplace(videoTexture_);
     videoSprite_->setScale({1.0f, 1.0f}); // Native scale
-    
-    // Buffer for 1280x720 RGBA
-    frameBuffer_.resize(1280 * 720 * 4);
 
-    return true;
+    // -f image2pipe -vcodec rawvideo outputs raw pixels: yuv420p (1.4 MB/frame, converted to RGBA
+    // on the reader thread) unless settings.json has "intro_pixel_format": "rgba" (3.7 MB/frame)
+    std::string pixelFormat = "yuv420p";
+    std::ifstream settingsFile("config/settings.json");
+    if (settingsFile) {
+        try {
+            nlohmann::json settings;
+            settingsFile >> settings;
+            pixelFormat = settings.value("intro_pixel_format", pixelFormat);
+        } catch (const std::exception& e) {
+            std::cerr << "IntroScreen: Error parsing settings.json: " << e.what() << "\n";
+        }
+    }
+
+    // The cache holds yuv420p frames, so the rgba pipe always goes through ffmpeg. A cache of another
+    // size is refused here and recorded again by the pipe below.
+    if (pixelFormat != "rgba" && cached && videoReader_.openCache(cachePath, VIDEO_WIDTH, VIDEO_HEIGHT)) {
+        std::cout << "IntroScreen: Playing cached intro (" << yuv::kernelName() << " conversion, no ffmpeg)\n";
+        return true;
+    }
+
+    // 3. Open Video Pipe
+    // -vf scale=1280:720,fps=30: Native 720p at 30fps
+    if (pixelFormat == "rgba") {
+        std::string cmd = "ffmpeg -i \"" + videoPath + "\" -vf scale=1280:720,fps=30 -f image2pipe -vcodec rawvideo -pix_fmt rgba -loglevel quiet -";
+        return videoReader_.open(cmd, VIDEO_WIDTH, VIDEO_HEIGHT, VIDEO_FPS);
+    }
+
+    // Pin the matrix and range so the converter's BT.601 coefficients match whatever the source is tagged as
+    std::string cmd = "ffmpeg -i \"" + videoPath + "\" -vf scale=1280:720:out_color_matrix=bt601:out_range=tv,fps=30 "
+                      "-f image2pipe -vcodec rawvideo -pix_fmt yuv420p -loglevel quiet -";
+    std::cout << "IntroScreen: yuv420p pipe, " << yuv::kernelName() << " conversion, recording " << cachePath << "\n";
+    return videoReader_.open(cmd, VIDEO_WIDTH, VIDEO_HEIGHT, VIDEO_FPS, VideoPipeReader::PixelFormat::Yuv420,
+                             cachePath, videoPath);
 }
 
 void IntroScreen::stopVideo() {
-    if (ffmpegPipe_) {
-        PCLOSE(ffmpegPipe_);
-        ffmpegPipe_ = nullptr;
+    if (videoReader_.isOpen()) {
+        const VideoPipeReader::Stats stats = videoReader_.stats();
+        std::cout << "IntroScreen: Video stopped after " << stats.shown << " frames ("
+                  << stats.dropped << " dropped, " << stats.repeated << " repeated, "
+                  << stats.stalls << " pipe stalls)\n";
+        videoReader_.close();
     }
     videoAudio_.stop();
 }
@@ -198,25 +219,41 @@ void IntroScreen::draw(sf::RenderWindow& window) {
 }
 
 void IntroScreen::updateVideo(float dt) {
-    if (!ffmpegPipe_) return;
+    if (!videoReader_.isOpen()) return;
+
+    bool changed = false;
+    if (!videoStarted_) {
+        // Hold the clock (and the audio) at zero until ffmpeg has produced the first frame
+        const std::uint8_t* first = videoReader_.frameAt(0.0, changed);
+        if (!first) {
+            if (videoReader_.isFinished(0.0)) {
+                std::cout << "IntroScreen: Video produced no frames. Switching to PSP Logo.\n";
+                stopVideo();
+                isVideoMode_ = false;
+                time_ = 0.f;
+            }
+            return;
+        }
+        videoTexture_.update(first);
+        if (videoAudio_.getDuration() > sf::Time::Zero) videoAudio_.play();
+        videoStarted_ = true;
+        return;
+    }
 
-    videoTimer_ += dt;
-    const float frameDuration = 1.0f / 30.0f; // Target 30 FPS
+    // The audio is the master clock; past its end (or without audio) the frame time carries on
+    videoClock_ += dt;
+    if (videoAudio_.getStatus() == sf::SoundSource::Status::Playing) {
+        videoClock_ = videoAudio_.getPlayingOffset().asSeconds();
+    }
 
-    if (videoTimer_ >= frameDuration) {
-        videoTimer_ -= frameDuration;
+    if (const std::uint8_t* pixels = videoReader_.frameAt(videoClock_, changed)) {
+        if (changed) videoTexture_.update(pixels);
+    }
 
-        // Read one frame from the pipe
-        size_t read = fread(frameBuffer_.data(), 1, frameBuffer_.size(), ffmpegPipe_);
-        
-        if (read == frameBuffer_.size()) {
-            videoTexture_.update(frameBuffer_.data());
-        } else {
-            // End of stream or error
-            std::cout << "IntroScreen: Video finished. Switching to PSP Logo.\n";
-            stopVideo();
-            isVideoMode_ = false;
-            time_ = 0.f;
-        }
+    if (videoReader_.isFinished(videoClock_)) {
+        std::cout << "IntroScreen: Video finished. Switching to PSP Logo.\n";
+        stopVideo();
+        isVideoMode_ = false;
+        time_ = 0.f;
     }
 }
@@ -1,10 +1,9 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include "VideoPipeReader.hpp"
 #include <string>
 #include <optional>
-#include <vector>
-#include <cstdio>
 
 class UiSoundBank;
 
@@ -24,6 +23,7 @@ public:
     void draw(sf::RenderWindow& window);
 
     bool isFinished() const { return finished_; }
+    bool isAnimating() const { return !finished_; }
 
 private:
     // Video Playback Methods
@@ -49,11 +49,15 @@ private:
     UiSoundBank& soundBank_;
 
     // Video State
+    // Frames are decoded ahead on a reader thread and picked by the audio clock
+    static constexpr unsigned int VIDEO_WIDTH = 1280;
+    static constexpr unsigned int VIDEO_HEIGHT = 720;
+    static constexpr float VIDEO_FPS = 30.f;
     bool isVideoMode_ = false;
-    FILE* ffmpegPipe_ = nullptr;
+    VideoPipeReader videoReader_;
     sf::Texture videoTexture_;
     std::optional<sf::Sprite> videoSprite_;
-    std::vector<uint8_t> frameBuffer_;
     sf::Music videoAudio_;
-    float videoTimer_ = 0.f;
+    bool videoStarted_ = false; // Audio starts with the first decoded frame
+    double videoClock_ = 0.0;   // Seconds into the video; follows the audio while it plays
 };
@@ -22,6 +22,9 @@ Launcher::Launcher(const std::string& settingsPath) {
     ppssppPath_ = j.value("ppsspp_path", std::string(""));
     gamesRoot_ = j.value("games_root", std::string(""));
     emulatorFullscreen_ = j.value("emulator_fullscreen", true);
+    launchViaShell_ = j.value("launch_via_shell", false);
+    earlyLaunch_ = j.value("early_launch", true);
+    romPrefetchMb_ = j.value("rom_prefetch_mb", 64u);
     
     if (ppssppPath_.empty()) {
       std::cerr << "Warning: ppsspp_path is missing in settings.json\n";
@@ -34,37 +37,42 @@ Launcher::Launcher(const std::string& settingsPath) {
   }
 }
 
-void Launcher::launchItem(const MenuItem& item, bool useController) {
+std::string Launcher::emulatorProcessName() const {
+  if (ppssppPath_.empty()) return "PPSSPP";
+  return fs::path(ppssppPath_).stem().string();
+}
+
+std::string Launcher::gamePathFor(const MenuItem& item) const {
+  if ((item.type != "psp_iso" && item.type != "psp_eboot") || item.path.empty()) {
+    return "";
+  }
+
+  fs::path gamePath(item.path);
+  
+  // If path is not absolute, treat it as relative to gamesRoot
+  if (!gamePath.is_absolute() && !gamesRoot_.empty()) {
+    gamePath = fs::path(gamesRoot_) / gamePath;
+  }
+  
+  // Convert to Windows-style backslashes
+  return gamePath.make_preferred().string();
+}
+
+std::optional<SpawnedProcess> Launcher::launchItem(const MenuItem& item, bool useController, bool startMinimized) {
   if (item.type == "psp_iso" || item.type == "psp_eboot") {
     if (ppssppPath_.empty()) {
       std::cerr << "PPSSPP path is not set in settings.json\n";
-      return;
+      return std::nullopt;
     }
     
     if (item.path.empty()) {
       std::cerr << "Item path is empty\n";
-      return;
+      return std::nullopt;
     }
     
-    // Build full game path
-    fs::path gamePath(item.path);
-    
-    // If path is not absolute, treat it as relative to gamesRoot
-    if (!gamePath.is_absolute() && !gamesRoot_.empty()) {
-      gamePath = fs::path(gamesRoot_) / gamePath;
-    }
-    
-    // Convert to Windows-style backslashes
-    std::string gamePathStr = gamePath.make_preferred().string();
+    std::string gamePathStr = gamePathFor(item);
     std::string ppssppPathWin = fs::path(ppssppPath_).make_preferred().string();
     
-    // Build command - put game path first, then flags
-    std::string cmd = "cmd /c start \"\" \"" + ppssppPathWin + "\" \"" + gamePathStr + "\"";
-    
-    if (emulatorFullscreen_) {
-      cmd += " --fullscreen";
-    }
-    
     // Configure input method
     if (useController) {
       std::cout << "Launching with PS5 Controller support\n";
@@ -72,13 +80,33 @@ void Launcher::launchItem(const MenuItem& item, bool useController) {
       std::cout << "Launching with Keyboard & Mouse\n";
     }
     
-    std::cout << "Launching PPSSPP: " << cmd << "\n";
-    int result = std::system(cmd.c_str());
+    if (launchViaShell_) {
+      // Build command - put game path first, then flags
+      std::string cmd = "cmd /c start \"\" \"" + ppssppPathWin + "\" \"" + gamePathStr + "\"";
+      
+      if (emulatorFullscreen_) {
+        cmd += " --fullscreen";
+      }
+      
+      std::cout << "Launching PPSSPP: " << cmd << "\n";
+      int result = std::system(cmd.c_str());
+      
+      if (result != 0) {
+        std::cerr << "PPSSPP exited with code " << result << "\n";
+      }
+      return std::nullopt;
+    }
     
-    if (result != 0) {
-      std::cerr << "PPSSPP exited with code " << result << "\n";
+    // Game path first, then flags; each argument reaches PPSSPP exactly as written
+    std::vector<std::string> argv = {ppssppPathWin, gamePathStr};
+    if (emulatorFullscreen_) {
+      argv.push_back("--fullscreen");
     }
+    
+    std::cout << "Launching PPSSPP: " << ppssppPathWin << " \"" << gamePathStr << "\"\n";
+    return spawnProcess(argv, startMinimized);
   } else if (item.type == "pc_app") {
+    // Through the shell: entries like "msinfo32.exe" rely on its PATH search and ".msc" ones on file association
     std::string cmd = "\"" + item.path + "\"";
     std::cout << "Launching PC app: " << cmd << "\n";
     std::system(cmd.c_str());
@@ -118,4 +146,5 @@ void Launcher::launchItem(const MenuItem& item, bool useController) {
   } else {
     std::cerr << "Unknown item type: " << item.type << "\n";
   }
+  return std::nullopt;
 }
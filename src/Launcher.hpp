@@ -1,15 +1,35 @@
 #pragma once
 
 #include "Menu.hpp"
+#include "ProcessSpawn.hpp"
+#include <cstdint>
+#include <optional>
 #include <string>
 
 class Launcher {
 public:
   Launcher(const std::string& settingsPath);
-  void launchItem(const MenuItem& item, bool useController = false);
+
+  // Returns the emulator process for PSP games so the caller can supervise it;
+  // nullopt for everything else, on failure, or when launching through the shell.
+  // startMinimized keeps the emulator window out of sight until revealProcessWindow().
+  std::optional<SpawnedProcess> launchItem(const MenuItem& item, bool useController = false, bool startMinimized = false);
+
+  // Full path of a PSP game's ISO/EBOOT (relative paths resolve against games_root); empty for other items
+  std::string gamePathFor(const MenuItem& item) const;
+
+  // Start PPSSPP while the startup animation plays instead of after it
+  bool earlyLaunch() const { return earlyLaunch_ && !launchViaShell_; }
+  std::uint64_t romPrefetchBytes() const { return romPrefetchMb_ * 1024ull * 1024ull; }
+
+  // Executable name of the emulator (e.g. "PPSSPPWindows64"), for finding a shell-launched instance
+  std::string emulatorProcessName() const;
 
 private:
   std::string ppssppPath_;
   std::string gamesRoot_;
   bool emulatorFullscreen_;
+  bool launchViaShell_ = false; // Old cmd /c start path, kept for comparing launch latency
+  bool earlyLaunch_ = true;
+  std::uint64_t romPrefetchMb_ = 64;
 };
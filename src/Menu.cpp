@@ -2,15 +2,23 @@
 #include "UserProfile.hpp"
 #include "UiSoundBank.hpp"
 #include "RomAssetManager.hpp"
+#include "PlayHistory.hpp"
+#include "PtfTheme.hpp"
+#include "ThemeBundle.hpp"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <iostream>
 #include <ctime>
 #include <cmath>
+#include <cctype>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 #include <algorithm>
 #include <map>
+#include <set>
+#include <numeric>
 #include <windows.h>
 #include <filesystem>
 #include <cstdint>
@@ -62,8 +70,71 @@ public:
     }
 };
 
-Menu::Menu(const std::string& configPath, UiSoundBank& sounds, UserProfile* profile)
-    : soundBank_(sounds), userProfile_(profile) {
+namespace {
+
+const char* const SORT_ORDER_IDS[] = {"title", "last_played", "play_time", "size", "region"};
+const char* const SORT_ORDER_NAMES[] = {"Title", "Last Played", "Play Time", "Size", "Region"};
+
+// Title folded so plain byte order is natural order: lowercase words, a leading article dropped
+// and digit runs zero-padded, so "The Warriors" files under W and "Game 2" precedes "Game 10"
+std::string makeCollationKey(const std::string& title) {
+  std::string words = SearchIndex::normalize(title);
+  for (const char* article : {"the ", "a ", "an "}) {
+    const size_t length = std::strlen(article);
+    if (words.size() > length && words.compare(0, length, article) == 0) {
+      words.erase(0, length);
+      break;
+    }
+  }
+
+  std::string key;
+  key.reserve(words.size() + 8);
+  for (size_t i = 0; i < words.size();) {
+    if (!std::isdigit(static_cast<unsigned char>(words[i]))) {
+      key.push_back(words[i++]);
+      continue;
+    }
+    size_t end = i;
+    while (end < words.size() && std::isdigit(static_cast<unsigned char>(words[end]))) ++end;
+    size_t first = i;
+    while (first + 1 < end && words[first] == '0') ++first;
+    if (end - first < 8) key.append(8 - (end - first), '0');
+    key.append(words, first, end - first);
+    i = end;
+  }
+  return key;
+}
+
+// Region from the third letter of the disc ID (ULUS, ULES, ULJM, NPUH, ...); 5 = unknown
+int regionRank(const std::string& discId) {
+  if (discId.size() < 3) return 5;
+  switch (std::toupper(static_cast<unsigned char>(discId[2]))) {
+    case 'U': return 0;
+    case 'E': return 1;
+    case 'J': return 2;
+    case 'A': case 'H': return 3;
+    case 'K': return 4;
+    default: return 5;
+  }
+}
+
+// Letter an item sorts under: first letter of its title (articles skipped), '#' for digits and symbols
+char letterGroup(const MenuItem& item) {
+  if (!item.collationKey.empty()) {
+    const unsigned char c = static_cast<unsigned char>(item.collationKey[0]);
+    return std::isalpha(c) ? static_cast<char>(std::toupper(c)) : '#';
+  }
+  for (char c : item.label) {
+    if (std::isalpha(static_cast<unsigned char>(c))) return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    if (!std::isspace(static_cast<unsigned char>(c))) return '#';
+  }
+  return '#';
+}
+
+} // namespace
+
+Menu::Menu(const std::string& configPath, UiSoundBank& sounds, UserProfile* profile, const PlayHistory* history)
+    : playHistory_(history), soundBank_(sounds), userProfile_(profile) {
   // Load font
   if (!font_.openFromFile("assets/fonts/ui_font.ttf")) {
     fontLoaded_ = false;
@@ -82,33 +153,101 @@ Menu::Menu(const std::string& configPath, UiSoundBank& sounds, UserProfile* prof
   loadFromFile(configPath);
   scanRomsFolder();  // Auto-scan Downloads folder for ROMs
   loadAssets();
+
+  // PSPV2_PERF_ITEMS=500 pads the Games list so draw cost can be measured on a big library
+  if (perf::enabled()) {
+    addSyntheticItems(perf::envCount("PSPV2_PERF_ITEMS"));
+  }
+  for (size_t c = 0; c < categories_.size(); ++c) {
+    if (categories_[c].id == "games") gamesCategoryIndex_ = c;
+  }
+  rebuildSearchIndex();
+  buildSortOrders();
+  applySortOrder(sortOrder_);
+
+  warmGlyphCache();
 }
 
 void Menu::reloadBackground() {
   std::string bgPath = "assets/Themes/Background.png";
+  bool bundle = false;
   
   // Use theme from profile if available
   if (userProfile_ && !userProfile_->getTheme().empty() && userProfile_->getTheme() != "default") {
-    bgPath = "assets/Backgrounds/" + userProfile_->getTheme();
+    const std::string& theme = userProfile_->getTheme();
+    bgPath = "assets/Backgrounds/" + theme;
+
+    // A PSP theme costs a header read plus its wallpaper, which is extracted once and reused
+    std::string extension = std::filesystem::path(theme).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    if (extension == ".ptf") {
+      PtfTheme ptf;
+      std::string wallpaper;
+      if (ptf.open("assets/Themes/" + theme)) wallpaper = ptf.wallpaperPath();
+      if (!wallpaper.empty()) bgPath = wallpaper;
+    } else if (extension == ThemeBundle::EXTENSION) {
+      // A saved custom theme already holds its rendered background
+      bgPath = "assets/Themes/" + theme;
+      bundle = true;
+    }
   }
   
+  // Picking the theme that is already shown, unchanged on disk, needs no decode
+  std::error_code ec;
+  const auto bgMtime = static_cast<std::int64_t>(std::filesystem::last_write_time(bgPath, ec).time_since_epoch().count());
+  if (bgLoaded_ && !customBgTexture_ && !ec && bgPath == bgLoadedPath_ && bgMtime == bgLoadedMtime_) return;
+
+  // Read/decode and upload are timed apart, so a bundle and an image file can be compared with PSPV2_PERF=1
+  sf::Clock timer;
+  double readMs = 0.0;
   try {
-    bgTexture_ = sf::Texture(bgPath);
+    if (bundle) {
+      // One read of the file, then one upload straight from its buffer
+      ThemeBundle themeBundle;
+      if (!themeBundle.load(bgPath)) throw std::runtime_error("unreadable theme bundle");
+      readMs = timer.restart().asMicroseconds() / 1000.0;
+      if (!bgTexture_.resize(themeBundle.backgroundSize())) throw std::runtime_error("cannot create texture");
+      bgTexture_.update(themeBundle.backgroundPixels());
+    } else {
+      const sf::Image image(bgPath);
+      readMs = timer.restart().asMicroseconds() / 1000.0;
+      bgTexture_ = sf::Texture(image);
+    }
+    const double uploadMs = timer.getElapsedTime().asMicroseconds() / 1000.0;
     bgLoaded_ = true;
-    bgSprite_ = sf::Sprite(bgTexture_);
-    bgSprite_->setTextureRect(sf::IntRect({0, 0}, sf::Vector2i(bgTexture_.getSize())));
-    // Scale background slightly larger for parallax effect
-    float scaleX = 1320.f / bgTexture_.getSize().x;  // 40px extra for movement
-    float scaleY = 760.f / bgTexture_.getSize().y;   // 40px extra for movement
-    bgSprite_->setScale({scaleX, scaleY});
-    bgSprite_->setPosition({-20.f, -20.f}); // Center the extra space
+    bgLoadedPath_ = bgPath;
+    bgLoadedMtime_ = bgMtime;
+    fitBackgroundSprite(bgTexture_);
+    customBgTexture_.reset();
     std::cout << "Loaded background: " << bgPath << "\n";
+    if (perf::enabled()) {
+      std::cout << "[Perf] Background " << (bundle ? "bundle read " : "image decode ") << readMs << " ms, upload "
+                << uploadMs << " ms (" << bgTexture_.getSize().x << "x" << bgTexture_.getSize().y << ")\n";
+    }
   } catch (const std::exception& e) {
     std::cerr << "Warning: failed to load " << bgPath << ": " << e.what() << "\n";
     bgLoaded_ = false;
   }
 }
 
+void Menu::setCustomBackground(std::shared_ptr<const sf::Texture> texture) {
+  if (!texture) return;
+  customBgTexture_ = std::move(texture);
+  fitBackgroundSprite(*customBgTexture_);
+  bgLoaded_ = true;
+  bgLoadedPath_.clear();
+}
+
+void Menu::fitBackgroundSprite(const sf::Texture& texture) {
+  bgSprite_ = sf::Sprite(texture);
+  bgSprite_->setTextureRect(sf::IntRect({0, 0}, sf::Vector2i(texture.getSize())));
+  // Scale background slightly larger for parallax effect
+  float scaleX = 1320.f / texture.getSize().x;  // 40px extra for movement
+  float scaleY = 760.f / texture.getSize().y;   // 40px extra for movement
+  bgSprite_->setScale({scaleX, scaleY});
+  bgSprite_->setPosition({-20.f, -20.f}); // Center the extra space
+}
+
 void Menu::loadFromFile(const std::string& configPath) {
   std::ifstream ifs(configPath);
   if (!ifs) {
@@ -163,67 +302,28 @@ void Menu::loadAssets() {
       continue;
     }
     
+    // Icons are keyed by path in the atlas, so shared icons are packed once
     std::string iconPath = "assets/Icons/" + cat.iconFilename;
-    try {
-      cat.iconTex = sf::Texture(iconPath);
-      cat.iconTex.setSmooth(true); // Enable smooth filtering for zoomed icons
-      cat.iconSprite = sf::Sprite(cat.iconTex);
-      // Center origin for scaling
-      sf::Vector2u size = cat.iconTex.getSize();
-      cat.iconSprite->setOrigin({size.x / 2.f, size.y / 2.f});
+    if (const AtlasRegion* region = iconAtlas_.addFromFile(iconPath, iconPath)) {
+      cat.iconRegion = *region;
       std::cout << "Loaded icon: " << iconPath << " for category " << cat.label << "\n";
-    } catch (const std::exception& e) {
-      std::cerr << "Warning: failed to load icon " << iconPath << ": " << e.what() << "\n";
+    } else {
+      std::cerr << "Warning: failed to load icon " << iconPath << "\n";
     }
     
-    // Load icon textures for each item
+    // Load icon textures for each item (games already carry their ICON0 thumbnail from the scan)
     for (auto& item : cat.items) {
-      if (!item.iconFilename.empty()) {
+      if (!item.iconRegion && !item.iconFilename.empty()) {
         std::string itemIconPath = "assets/Icons/" + item.iconFilename;
-        try {
-          item.iconTex = sf::Texture(itemIconPath);
-          item.iconTex.setSmooth(true); // Enable smooth filtering
-          item.iconSprite = sf::Sprite(item.iconTex);
+        if (const AtlasRegion* region = iconAtlas_.addFromFile(itemIconPath, itemIconPath)) {
+          item.iconRegion = *region;
           std::cout << "Loaded icon: " << itemIconPath << " for item " << item.label << "\n";
-        } catch (const std::exception& e) {
-          std::cerr << "Warning: failed to load item icon " << itemIconPath << ": " << e.what() << "\n";
-        }
-      }
-
-      // Load preview image
-      if (!item.previewImagePath.empty()) {
-        if (item.previewTexture.loadFromFile(item.previewImagePath)) {
-            item.previewSprite.emplace(item.previewTexture);
-            item.hasPreview = true;
-            std::cout << "Loaded preview: " << item.previewImagePath << "\n";
         } else {
-            std::cerr << "Warning: failed to load preview " << item.previewImagePath << "\n";
+          std::cerr << "Warning: failed to load item icon " << itemIconPath << "\n";
         }
       }
 
-      // Load preview background
-      if (!item.previewBgPath.empty()) {
-        if (item.previewBgTexture.loadFromFile(item.previewBgPath)) {
-            item.previewBgTexture.setSmooth(true);
-            item.previewBgSprite.emplace(item.previewBgTexture);
-            item.hasPreviewBg = true;
-            std::cout << "Loaded preview bg: " << item.previewBgPath << "\n";
-        } else {
-            std::cerr << "Warning: failed to load preview bg " << item.previewBgPath << "\n";
-        }
-      }
-
-      // Load cover art
-      if (!item.coverArtPath.empty()) {
-        if (item.coverArtTexture.loadFromFile(item.coverArtPath)) {
-            item.coverArtTexture.setSmooth(true);
-            item.coverArtSprite.emplace(item.coverArtTexture);
-            item.hasCoverArt = true;
-            std::cout << "Loaded cover art: " << item.coverArtPath << "\n";
-        } else {
-            std::cerr << "Warning: failed to load cover art " << item.coverArtPath << "\n";
-        }
-      }
+      // Preview image, background and cover art are left to artCache_ (see refreshResidencyWindow)
 
       // Load preview audio
       if (!item.previewAudioPath.empty()) {
@@ -253,6 +353,11 @@ void Menu::loadSettings(const std::string& settingsPath) {
     ifs >> j;
     gamesRoot_ = j.value("games_root", std::string("Games"));
     std::cout << "Menu: Using games root: " << gamesRoot_ << "\n";
+
+    // Preview art residency: +/- radius items around the cursor, evicted beyond the budget.
+    // Read as int and clamped, so a negative value can't wrap into a window that never evicts
+    residencyRadius_ = static_cast<size_t>(std::clamp(j.value("residency_window", 20), 0, 200));
+    artCache_.setBudget(static_cast<size_t>(std::clamp(j.value("texture_budget_mb", 256), 16, 4096)) * 1024u * 1024u);
   } catch (const std::exception& e) {
     std::cerr << "Error parsing settings.json: " << e.what() << "\n";
     gamesRoot_ = "Games";  // Fallback
@@ -617,6 +722,11 @@ void Menu::scanRomsFolder() {
         item.type = hasExtension(lower, ".pbp") ? "psp_eboot" : "psp_iso";
         item.iconFilename = "psp UMD.png";
 
+        // Known even when extraction fails, so the size sort still places the game
+        std::error_code sizeError;
+        const std::uintmax_t size = entry.file_size(sizeError);
+        item.sizeBytes = sizeError ? 0 : size;
+
         // Extract metadata from ROM - use full absolute path
         std::string fullPath = entry.path().string();
         try {
@@ -629,47 +739,28 @@ void Menu::scanRomsFolder() {
             if (!assets.title.empty()) {
                 item.label = assets.title;
             }
+            item.discId = assets.discId;
             
             if (!assets.iconPath.empty()) {
                 item.previewImagePath = assets.iconPath;
                 
-                // Load for list icon
-                if (item.iconTex.loadFromFile(assets.iconPath)) {
-                    item.iconTex.setSmooth(true); // Enable smoothing
-                    item.iconSprite.emplace(item.iconTex);
-                    sf::Vector2u size = item.iconTex.getSize();
-                    item.iconSprite->setOrigin({size.x / 2.f, size.y / 2.f});
-                    item.iconSprite->setScale({0.5f, 0.5f});
-                }
-
-                // Load for preview card
-                if (item.previewTexture.loadFromFile(assets.iconPath)) {
-                    item.previewTexture.setSmooth(true); // Enable smoothing
-                    item.previewSprite.emplace(item.previewTexture);
-                    item.hasPreview = true;
+                // Pack a small thumbnail for the list icon; the atlas grows a page at a time as games are found
+                if (const AtlasRegion* region = iconAtlas_.addFromFile(assets.iconPath, assets.iconPath, GAME_ICON_ATLAS_EDGE)) {
+                    item.iconRegion = *region;
                 }
             }
             
+            // Full-size art is only decoded when the item comes near the cursor
             if (!assets.backgroundPath.empty()) {
                 item.previewBgPath = assets.backgroundPath;
-                item.coverArtPath = assets.backgroundPath;
-
-                if (item.previewBgTexture.loadFromFile(assets.backgroundPath)) {
-                    item.previewBgTexture.setSmooth(true);
-                    item.previewBgSprite.emplace(item.previewBgTexture);
-                    item.hasPreviewBg = true;
-                }
-                
-                if (item.coverArtTexture.loadFromFile(assets.backgroundPath)) {
-                    item.coverArtTexture.setSmooth(true);
-                    item.coverArtSprite.emplace(item.coverArtTexture);
-                    item.hasCoverArt = true;
-                }
             }
+            // PIC0 is the cover when the game has one; otherwise the background doubles as it
+            item.coverArtPath = !assets.coverPath.empty() ? assets.coverPath : assets.backgroundPath;
             
             if (!assets.audioPath.empty()) {
                 item.previewAudioPath = assets.audioPath;
             }
+            item.previewVideoPath = assets.iconVideoPath;
 
             std::cout << "Processed assets for " << filename << "\n";
 
@@ -688,43 +779,26 @@ void Menu::scanRomsFolder() {
 }
 
 void Menu::handleEvent(const sf::Event& event) {
+  // Any real input wakes the idle animations back up
+  if (event.is<sf::Event::KeyPressed>() || event.is<sf::Event::JoystickButtonPressed>()) {
+    inputIdleTime_ = 0.f;
+  } else if (const auto* moved = event.getIf<sf::Event::JoystickMoved>()) {
+    if (std::abs(moved->position) > 50.f) inputIdleTime_ = 0.f;
+  }
+
+  if (searchActive_) {
+    handleSearchEvent(event);
+    return;
+  }
+
+  // Arrows, D-pad, stick and shoulder buttons: one step per press, then controlled repeat from update()
+  if (const auto action = navInput_.handleEvent(event)) {
+    applyNavAction(*action, false);
+  }
+
   // Handle keyboard input
   if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-    if (keyPressed->code == sf::Keyboard::Key::Left) {
-      if (!categories_.empty()) {
-        if (currentCategoryIndex_ == 0) {
-          currentCategoryIndex_ = categories_.size() - 1;
-        } else {
-          --currentCategoryIndex_;
-        }
-        currentItemIndex_ = 0; // Reset item selection
-        targetBgOffsetX_ += 15.f; // Move background right
-        soundBank_.playCategoryDecide();
-      }
-    } else if (keyPressed->code == sf::Keyboard::Key::Right) {
-      if (!categories_.empty()) {
-        currentCategoryIndex_ = (currentCategoryIndex_ + 1) % categories_.size();
-        currentItemIndex_ = 0; // Reset item selection
-        targetBgOffsetX_ -= 15.f; // Move background left
-        soundBank_.playCategoryDecide();
-      }
-    } else if (keyPressed->code == sf::Keyboard::Key::Up) {
-      if (!categories_.empty() && !categories_[currentCategoryIndex_].items.empty()) {
-        if (currentItemIndex_ == 0) {
-          currentItemIndex_ = categories_[currentCategoryIndex_].items.size() - 1;
-        } else {
-          --currentItemIndex_;
-        }
-        targetBgOffsetY_ += 5.f; // Move background down slightly
-        soundBank_.playCursor();
-      }
-    } else if (keyPressed->code == sf::Keyboard::Key::Down) {
-      if (!categories_.empty() && !categories_[currentCategoryIndex_].items.empty()) {
-        currentItemIndex_ = (currentItemIndex_ + 1) % categories_[currentCategoryIndex_].items.size();
-        targetBgOffsetY_ -= 5.f; // Move background up slightly
-        soundBank_.playCursor();
-      }
-    } else if (keyPressed->code == sf::Keyboard::Key::Enter) {
+    if (keyPressed->code == sf::Keyboard::Key::Enter) {
       if (!categories_.empty() && !categories_[currentCategoryIndex_].items.empty()) {
         launchRequested_ = true;
         soundBank_.playDecide();
@@ -733,6 +807,13 @@ void Menu::handleEvent(const sf::Event& event) {
       }
     } else if (keyPressed->code == sf::Keyboard::Key::Escape) {
       soundBank_.playCancel();
+    } else if (keyPressed->code == sf::Keyboard::Key::Slash) {
+      openSearch();
+    } else if (keyPressed->code == sf::Keyboard::Key::Tab) {
+      cycleSortOrder();
+    } else if (keyPressed->code >= sf::Keyboard::Key::A && keyPressed->code <= sf::Keyboard::Key::Z) {
+      // Type a letter to jump to the next title starting with it
+      jumpToLetter(static_cast<char>('A' + (static_cast<int>(keyPressed->code) - static_cast<int>(sf::Keyboard::Key::A))));
     }
   }
   
@@ -751,88 +832,207 @@ void Menu::handleEvent(const sf::Event& event) {
     else if (joystickButtonPressed->button == 1) {
       soundBank_.playCancel();
     }
+    // Button 3 = Triangle/Y (sort order)
+    else if (joystickButtonPressed->button == 3) {
+      cycleSortOrder();
+    }
   }
-  
-  // Handle D-pad
-  if (const auto* joystickMoved = event.getIf<sf::Event::JoystickMoved>()) {
-    const float deadzone = 50.f;
-    
-    // Horizontal axis (D-pad left/right or left stick)
-    if (joystickMoved->axis == sf::Joystick::Axis::X || joystickMoved->axis == sf::Joystick::Axis::PovX) {
-      if (joystickMoved->position < -deadzone) {
-        // Left
-        if (!categories_.empty()) {
-          if (currentCategoryIndex_ == 0) {
-            currentCategoryIndex_ = categories_.size() - 1;
-          } else {
-            --currentCategoryIndex_;
-          }
-          currentItemIndex_ = 0;
-          targetBgOffsetX_ += 15.f;
-          soundBank_.playCategoryDecide();
-        }
-      } else if (joystickMoved->position > deadzone) {
-        // Right
-        if (!categories_.empty()) {
-          currentCategoryIndex_ = (currentCategoryIndex_ + 1) % categories_.size();
-          currentItemIndex_ = 0;
-          targetBgOffsetX_ -= 15.f;
-          soundBank_.playCategoryDecide();
-        }
-      }
+}
+
+InputRepeater::Config Menu::itemNavigationConfig() {
+  InputRepeater::Config config;
+  config.repeatHorizontal = false; // A held Left/Right would spin through the categories
+  return config;
+}
+
+void Menu::applyNavAction(NavAction action, bool repeated) {
+  inputIdleTime_ = 0.f;
+  if (searchActive_) {
+    // Only the result cursor moves while the search box is open
+    if (searchResults_.empty() || (action != NavAction::Up && action != NavAction::Down)) return;
+    const size_t count = searchResults_.size();
+    searchCursor_ = (searchCursor_ + count + (action == NavAction::Up ? count - 1 : 1)) % count;
+    if (!repeated) soundBank_.playCursor();
+    return;
+  }
+  switch (action) {
+    case NavAction::Left: changeCategory(-1); break;
+    case NavAction::Right: changeCategory(1); break;
+    case NavAction::Up: moveItemCursor(-1, repeated); break;
+    case NavAction::Down: moveItemCursor(1, repeated); break;
+    case NavAction::PageUp: moveItemCursor(-static_cast<int>(PAGE_ITEMS), repeated); break;
+    case NavAction::PageDown: moveItemCursor(static_cast<int>(PAGE_ITEMS), repeated); break;
+    case NavAction::PrevLetter: jumpToLetterGroup(-1); break;
+    case NavAction::NextLetter: jumpToLetterGroup(1); break;
+    default: break;
+  }
+}
+
+void Menu::changeCategory(int direction) {
+  if (categories_.empty()) return;
+  if (direction < 0) {
+    currentCategoryIndex_ = currentCategoryIndex_ == 0 ? categories_.size() - 1 : currentCategoryIndex_ - 1;
+    targetBgOffsetX_ += 15.f; // Move background right
+  } else {
+    currentCategoryIndex_ = (currentCategoryIndex_ + 1) % categories_.size();
+    targetBgOffsetX_ -= 15.f; // Move background left
+  }
+  currentItemIndex_ = 0; // Reset item selection
+  soundBank_.playCategoryDecide();
+}
+
+void Menu::moveItemCursor(int direction, bool repeated) {
+  if (categories_.empty() || categories_[currentCategoryIndex_].items.empty()) return;
+  const size_t count = categories_[currentCategoryIndex_].items.size();
+
+  if (direction == 1 || direction == -1) {
+    // Single steps wrap around the ends
+    currentItemIndex_ = (currentItemIndex_ + count + direction) % count;
+  } else {
+    // Page jumps stop at the ends
+    const long target = static_cast<long>(currentItemIndex_) + direction;
+    currentItemIndex_ = static_cast<size_t>(std::clamp(target, 0L, static_cast<long>(count) - 1));
+  }
+  noteItemStep(direction < 0 ? -1 : 1);
+  targetBgOffsetY_ += direction < 0 ? 5.f : -5.f; // Nudge the background against the movement
+
+  // At 40 items/s one cursor tick per step would just be noise
+  const float now = navClock_.getElapsedTime().asSeconds();
+  if (!repeated || now - lastCursorSoundTime_ >= CURSOR_SOUND_INTERVAL) {
+    soundBank_.playCursor();
+    lastCursorSoundTime_ = now;
+  }
+}
+
+void Menu::jumpToItem(size_t index) {
+  if (index == currentItemIndex_) return;
+  const int direction = index > currentItemIndex_ ? 1 : -1;
+  currentItemIndex_ = index;
+  noteItemStep(direction);
+  targetBgOffsetY_ += direction < 0 ? 5.f : -5.f;
+  soundBank_.playCursor();
+}
+
+void Menu::jumpToLetter(char letter) {
+  if (categories_.empty()) return;
+  const auto& items = categories_[currentCategoryIndex_].items;
+  if (currentCategoryIndex_ == gamesCategoryIndex_ && sortOrder_ == SortOrder::Title) {
+    // Title order keeps each letter contiguous: step within the run, otherwise go to its start
+    const size_t start = letterStarts_[static_cast<size_t>(letter - 'A') + 1];
+    if (start == static_cast<size_t>(-1)) {
+      soundBank_.playError();
+      return;
     }
-    
-    // Vertical axis (D-pad up/down or left stick)
-    if (joystickMoved->axis == sf::Joystick::Axis::Y || joystickMoved->axis == sf::Joystick::Axis::PovY) {
-      if (joystickMoved->position > deadzone) {
-        // Up (inverted)
-        if (!categories_.empty() && !categories_[currentCategoryIndex_].items.empty()) {
-          if (currentItemIndex_ == 0) {
-            currentItemIndex_ = categories_[currentCategoryIndex_].items.size() - 1;
-          } else {
-            --currentItemIndex_;
-          }
-          targetBgOffsetY_ += 5.f;
-          soundBank_.playCursor();
-        }
-      } else if (joystickMoved->position < -deadzone) {
-        // Down (inverted)
-        if (!categories_.empty() && !categories_[currentCategoryIndex_].items.empty()) {
-          currentItemIndex_ = (currentItemIndex_ + 1) % categories_[currentCategoryIndex_].items.size();
-          targetBgOffsetY_ -= 5.f;
-          soundBank_.playCursor();
-        }
-      }
+    size_t index = start;
+    if (letterGroup(items[currentItemIndex_]) == letter && currentItemIndex_ + 1 < items.size() &&
+        letterGroup(items[currentItemIndex_ + 1]) == letter) {
+      index = currentItemIndex_ + 1;
+    }
+    inputIdleTime_ = 0.f;
+    jumpToItem(index);
+    return;
+  }
+  for (size_t step = 1; step <= items.size(); ++step) {
+    const size_t index = (currentItemIndex_ + step) % items.size();
+    if (letterGroup(items[index]) == letter) {
+      inputIdleTime_ = 0.f;
+      jumpToItem(index);
+      return;
+    }
+  }
+  soundBank_.playError();
+}
+
+void Menu::jumpToLetterGroup(int direction) {
+  if (categories_.empty() || categories_[currentCategoryIndex_].items.empty()) return;
+  const auto& items = categories_[currentCategoryIndex_].items;
+  const char current = groupOf(items[currentItemIndex_]);
+  if (current == 0) {
+    // Orders without groups (play time, size, ...) page instead
+    moveItemCursor(direction * static_cast<int>(PAGE_ITEMS), false);
+    return;
+  }
+  size_t index = currentItemIndex_;
+
+  if (direction > 0) {
+    // First item of the next run of a different group
+    while (index + 1 < items.size() && groupOf(items[index]) == current) ++index;
+    if (groupOf(items[index]) == current) index = 0; // Last group: wrap to the top
+  } else {
+    // Start of this run, or of the previous one if already there
+    if (index > 0 && groupOf(items[index - 1]) == current) {
+      while (index > 0 && groupOf(items[index - 1]) == current) --index;
+    } else {
+      index = index == 0 ? items.size() - 1 : index - 1;
+      const char previous = groupOf(items[index]);
+      while (index > 0 && groupOf(items[index - 1]) == previous) --index;
     }
   }
+  jumpToItem(index);
 }
 
 void Menu::update(float dt) {
+  // A finished game moves in the history orders; re-sort if one of those is showing
+  if (playHistory_ && playHistory_->revision() != historyRevision_) {
+    buildHistoryOrders();
+    if (sortOrder_ == SortOrder::LastPlayed || sortOrder_ == SortOrder::PlayTime) applySortOrder(sortOrder_);
+  }
+
+  // Held directions repeat here, before the selection change is picked up below
+  for (NavAction action : navInput_.update(dt)) {
+    applyNavAction(action, true);
+  }
+
   // Check for selection change to update preview audio
   if (currentCategoryIndex_ != lastCategoryIndex_ || currentItemIndex_ != lastItemIndex_) {
     lastCategoryIndex_ = currentCategoryIndex_;
     lastItemIndex_ = currentItemIndex_;
     
-    // Stop previous sound
-    if (previewSoundPlayer_) previewSoundPlayer_->stop();
-    
-    // Play new sound if available
-    if (!categories_.empty() && !categories_[currentCategoryIndex_].items.empty()) {
-        const auto& item = categories_[currentCategoryIndex_].items[currentItemIndex_];
-        if (item.hasPreviewAudio && item.previewBuffer) {
-            previewSoundPlayer_.emplace(*item.previewBuffer);
-            previewSoundPlayer_->setLooping(true);
-            previewSoundPlayer_->play();
-        }
-    }
+    // Stop the previous item's video and sound; the new item's start once the cursor rests
+    stopPreviewPlayback();
     
     // Reset preview alpha on selection change
     previewAlpha_ = 0.f;
+    previewBgAlpha_ = 0.f;
+
+    refreshResidencyWindow();
+  }
+
+  // Once the cursor stops, let the full-size art for where it landed through
+  if (scrollDirection_ != 0 && navClock_.getElapsedTime().asSeconds() - lastStepTime_ > SCROLL_SETTLE_TIME) {
+    scrollDirection_ = 0;
+    scrollVelocity_ = 0.f;
+    if (fastScrolling_) {
+      fastScrolling_ = false;
+      refreshResidencyWindow();
+    }
   }
+
+  updatePreviewVideo(dt);
+
+  // Upload whatever the decode thread finished since last frame
+  artCache_.update();
   
-  // Update preview alpha
-  previewAlpha_ += 600.f * dt; // Fast fade in
-  if (previewAlpha_ > 255.f) previewAlpha_ = 255.f;
+  // Update preview alpha (the fade starts once the selected item's art is resident)
+  bool previewReady = true;
+  bool backgroundReady = false;
+  bool playbackPending = false; // Waiting out PREVIEW_PLAYBACK_DELAY for something to play
+  if (!categories_.empty() && !categories_[currentCategoryIndex_].items.empty()) {
+    const auto& item = categories_[currentCategoryIndex_].items[currentItemIndex_];
+    // Art that failed to decode counts as ready, so the placeholder fades in in its place
+    previewReady = item.previewImagePath.empty() || artCache_.find(item.previewImagePath) ||
+                   artCache_.hasFailed(item.previewImagePath);
+    backgroundReady = !item.previewBgPath.empty() && artCache_.find(item.previewBgPath);
+    playbackPending = !previewPlaybackStarted_ && (item.hasPreviewAudio || !item.previewVideoPath.empty());
+  }
+  if (previewReady) {
+    previewAlpha_ += 600.f * dt; // Fast fade in
+    if (previewAlpha_ > 255.f) previewAlpha_ = 255.f;
+  }
+  if (previewReady && backgroundReady) {
+    previewBgAlpha_ += 600.f * dt;
+    if (previewBgAlpha_ > 255.f) previewBgAlpha_ = 255.f;
+  }
 
   // Smooth scroll animation for item list
   const float lerpSpeed = 8.0f;
@@ -855,7 +1055,13 @@ void Menu::update(float dt) {
   }
 
   // Category scale animation (subtle pulse on selected)
-  categoryScaleAnim_ += dt * 2.0f;
+  // The pulse fades out on an idle menu so nothing needs redrawing
+  inputIdleTime_ += dt;
+  const float pulseTarget = inputIdleTime_ < PULSE_IDLE_SECONDS ? 1.f : 0.f;
+  pulseStrength_ += std::max(-dt, std::min(dt, pulseTarget - pulseStrength_));
+  if (pulseStrength_ > 0.f) {
+    categoryScaleAnim_ += dt * 2.0f;
+  }
 
   // Parallax background animation with spring back
   const float bgLerpSpeed = 5.0f;
@@ -872,6 +1078,147 @@ void Menu::update(float dt) {
   // Clamp to prevent excessive movement
   bgOffsetX_ = std::max(-20.f, std::min(20.f, bgOffsetX_));
   bgOffsetY_ = std::max(-20.f, std::min(20.f, bgOffsetY_));
+
+  // The lerps only approach their targets, so anything within a fraction of a pixel counts as settled
+  animating_ = pulseStrength_ > 0.f ||
+               navInput_.isHolding() ||
+               scrollDirection_ != 0 ||
+               artCache_.hasPendingWork() ||
+               playbackPending ||
+               previewVideo_.isOpen() ||
+               (previewReady && previewAlpha_ < 255.f) ||
+               (previewReady && backgroundReady && previewBgAlpha_ < 255.f) ||
+               std::abs(targetItemListOffset_ - itemListOffset_) > 0.25f ||
+               std::abs(targetCategoryScrollOffset_ - categoryScrollOffset_) > 0.002f ||
+               std::abs(targetBgOffsetX_ - bgOffsetX_) > 0.05f ||
+               std::abs(targetBgOffsetY_ - bgOffsetY_) > 0.05f ||
+               std::abs(targetBgOffsetX_) > 0.05f ||
+               std::abs(targetBgOffsetY_) > 0.05f;
+}
+
+void Menu::updatePreviewVideo(float dt) {
+  // ICON1 and SND0 wait until the cursor has rested on an item, like the XMB
+  selectionRestTime_ += dt;
+  if (!previewPlaybackStarted_ && scrollDirection_ == 0 && selectionRestTime_ >= PREVIEW_PLAYBACK_DELAY) {
+    startPreviewPlayback();
+  }
+  if (!previewVideo_.isOpen()) return;
+
+  // The clock holds at zero until ffmpeg has produced the first frame
+  if (previewVideoFrame_) previewVideoClock_ += dt;
+  bool changed = false;
+  if (const std::uint8_t* pixels = previewVideo_.frameAt(previewVideoClock_, changed)) {
+    if (changed) previewVideoTexture_.update(pixels);
+    previewVideoFrame_ = true;
+  }
+  // The stream loops, so this only happens when ffmpeg is missing or the video is broken
+  if (previewVideo_.isFinished(previewVideoClock_)) previewVideo_.close();
+}
+
+void Menu::startPreviewPlayback() {
+  previewPlaybackStarted_ = true;
+  if (categories_.empty() || categories_[currentCategoryIndex_].items.empty()) return;
+  const auto& item = categories_[currentCategoryIndex_].items[currentItemIndex_];
+
+  if (item.hasPreviewAudio && item.previewBuffer) {
+    previewSoundPlayer_.emplace(*item.previewBuffer);
+    previewSoundPlayer_->setLooping(true);
+    previewSoundPlayer_->play();
+  }
+
+  if (item.previewVideoPath.empty()) return;
+  if (previewVideoTexture_.getSize().x == 0) {
+    if (!previewVideoTexture_.resize({ICON1_WIDTH, ICON1_HEIGHT})) return;
+    previewVideoTexture_.setSmooth(true);
+  }
+  // Raw H.264 carries no timing, so the PSP's 29.97 fps is given; -stream_loop repeats it like the XMB does
+  const std::string cmd = "ffmpeg -stream_loop -1 -f h264 -framerate 30000/1001 -i \"" + item.previewVideoPath + "\" "
+                          "-vf scale=144:80:out_color_matrix=bt601:out_range=tv,fps=30 "
+                          "-f image2pipe -vcodec rawvideo -pix_fmt yuv420p -loglevel quiet -";
+  previewVideoClock_ = 0.0;
+  previewVideo_.open(cmd, ICON1_WIDTH, ICON1_HEIGHT, ICON1_FPS, VideoPipeReader::PixelFormat::Yuv420);
+}
+
+void Menu::stopPreviewPlayback() {
+  if (previewSoundPlayer_) previewSoundPlayer_->stop();
+  // Closing tells the reader thread and ffmpeg to stop without waiting for them; nothing decoded for this item is kept
+  previewVideo_.close();
+  previewVideoFrame_ = false;
+  previewPlaybackStarted_ = false;
+  selectionRestTime_ = 0.f;
+}
+
+void Menu::refreshResidencyWindow() {
+  std::vector<std::string> pinned; // Everything in the window keeps whatever is already resident
+  std::vector<std::string> fetch;  // What is worth decoding right now, most urgent first
+  if (!categories_.empty()) {
+    const auto& items = categories_[currentCategoryIndex_].items;
+    const size_t count = items.size();
+    const size_t radius = std::min(residencyRadius_, count / 2);
+
+    // While scrolling fast only ICON0 is decoded; PIC1 waits until the cursor settles
+    auto addItem = [&](size_t index) {
+      const auto& item = items[index];
+      pinned.push_back(item.previewBgPath);
+      pinned.push_back(item.previewImagePath);
+      if (item.coverArtPath != item.previewBgPath) pinned.push_back(item.coverArtPath);
+
+      fetch.push_back(item.previewImagePath);
+      if (!fastScrolling_) {
+        fetch.push_back(item.previewBgPath);
+        if (item.coverArtPath != item.previewBgPath) fetch.push_back(item.coverArtPath);
+      }
+    };
+    auto offsetIndex = [&](int direction, size_t distance) {
+      return direction > 0 ? (currentItemIndex_ + distance) % count
+                           : (currentItemIndex_ + count - distance) % count;
+    };
+
+    if (count > 0) addItem(currentItemIndex_);
+
+    // Items the cursor will reach within the prefetch horizon come next, in travel order
+    size_t ahead = 0;
+    if (scrollDirection_ != 0) {
+      ahead = std::min(radius, static_cast<size_t>(std::ceil(scrollVelocity_ * PREFETCH_HORIZON)) + 1);
+      for (size_t d = 1; d <= ahead; ++d) {
+        addItem(offsetIndex(scrollDirection_, d));
+      }
+    }
+
+    // Then the rest of the window, alternating below/above
+    for (size_t d = 1; d <= radius; ++d) {
+      if (scrollDirection_ <= 0 || d > ahead) addItem(offsetIndex(1, d));
+      if (scrollDirection_ >= 0 || d > ahead) addItem(offsetIndex(-1, d));
+    }
+  }
+  artCache_.setResidencyWindow(pinned, fetch);
+}
+
+void Menu::noteItemStep(int direction) {
+  const float now = navClock_.getElapsedTime().asSeconds();
+  const float interval = lastStepTime_ < 0.f ? SCROLL_SETTLE_TIME + 1.f : now - lastStepTime_;
+  lastStepTime_ = now;
+
+  if (direction != scrollDirection_ || interval > SCROLL_SETTLE_TIME) {
+    // Fresh press or a reversal: speed is unknown until the next step.
+    // The next refreshResidencyWindow() re-ranks the queue, dropping what was prefetched the other way.
+    scrollDirection_ = direction;
+    scrollVelocity_ = 0.f;
+  } else {
+    const float instant = 1.f / std::max(interval, 1.f / 120.f);
+    scrollVelocity_ = scrollVelocity_ > 0.f ? scrollVelocity_ * 0.5f + instant * 0.5f : instant;
+  }
+  fastScrolling_ = scrollVelocity_ >= FAST_SCROLL_SPEED;
+}
+
+void Menu::visibleItemRange(size_t itemCount, size_t& first, size_t& last) const {
+  // Rows are laid out at ITEM_LIST_START_Y + i * ITEM_ROW_HEIGHT + itemListOffset_
+  const float top = -ITEM_ROW_HEIGHT - ITEM_LIST_START_Y - itemListOffset_;
+  const float bottom = 720.f - ITEM_LIST_START_Y - itemListOffset_;
+  const float firstRow = std::floor(top / ITEM_ROW_HEIGHT);
+  const float lastRow = std::ceil(bottom / ITEM_ROW_HEIGHT) + 1.f;
+  first = static_cast<size_t>(std::clamp(firstRow, 0.f, static_cast<float>(itemCount)));
+  last = static_cast<size_t>(std::clamp(lastRow, 0.f, static_cast<float>(itemCount)));
 }
 
 sf::Vector2f Menu::getCategoryIconPosition(size_t index) const {
@@ -896,11 +1243,14 @@ std::string Menu::getItemTypeDisplay(const std::string& type) const {
   return "Unknown";
 }
 
-void Menu::draw(sf::RenderWindow& window) {
+void Menu::draw(sf::RenderTarget& window) {
+  drawCalls_ = 0;
+  drawTimer_.restart();
+
   // 1. Background with parallax offset
   if (bgLoaded_ && bgSprite_.has_value()) {
     bgSprite_->setPosition({-20.f + bgOffsetX_, -20.f + bgOffsetY_});
-    window.draw(*bgSprite_);
+    submit(window, *bgSprite_);
   } else {
     window.clear(sf::Color(5, 5, 5)); // Very dark gray
   }
@@ -909,43 +1259,11 @@ void Menu::draw(sf::RenderWindow& window) {
 
   // 2. Top bar
   // Title with username
-  std::string titleStr = "PSPV2";
-  if (userProfile_ && !userProfile_->getUserName().empty()) {
-    titleStr = "Welcome, " + userProfile_->getUserName();
-  }
-  sf::Text titleText(font_, titleStr, 24);
+  refreshHeaderStrings();
+  sf::Text& titleText = cachedText(titleString_, 24);
   titleText.setFillColor(sf::Color::White);
   titleText.setPosition({20.f, 20.f});
-  window.draw(titleText);
-
-  // Date and Time (if enabled in profile)
-  std::time_t now = std::time(nullptr);
-  std::tm* localTime = std::localtime(&now);
-  
-  std::ostringstream dateTimeStream;
-  
-  // Show date if enabled
-  if (userProfile_ && userProfile_->getShowDate()) {
-    dateTimeStream << std::setfill('0') << std::setw(2) << (localTime->tm_mon + 1) << "/"
-                   << std::setfill('0') << std::setw(2) << localTime->tm_mday << "/"
-                   << (localTime->tm_year + 1900) << "  ";
-  }
-  
-  // Show time if enabled
-  if (userProfile_ && userProfile_->getShowClock()) {
-    if (userProfile_->getUse24HourFormat()) {
-      // 24-hour format
-      dateTimeStream << std::setfill('0') << std::setw(2) << localTime->tm_hour << ":"
-                     << std::setfill('0') << std::setw(2) << localTime->tm_min;
-    } else {
-      // 12-hour format with AM/PM
-      int hour12 = localTime->tm_hour % 12;
-      if (hour12 == 0) hour12 = 12; // Convert 0 to 12
-      dateTimeStream << hour12 << ":"
-                     << std::setfill('0') << std::setw(2) << localTime->tm_min << " "
-                     << (localTime->tm_hour < 12 ? "AM" : "PM");
-    }
-  }
+  submit(window, titleText);
   
   // Battery icon (positioned before date/time to avoid overlap)
   sf::RectangleShape batteryOutline({40.f, 18.f});
@@ -953,29 +1271,30 @@ void Menu::draw(sf::RenderWindow& window) {
   batteryOutline.setFillColor(sf::Color::Transparent);
   batteryOutline.setOutlineColor(sf::Color::White);
   batteryOutline.setOutlineThickness(2.f);
-  window.draw(batteryOutline);
+  submit(window, batteryOutline);
   
   sf::RectangleShape batteryFill({32.f, 10.f});
   batteryFill.setPosition({1004.f, 28.f});
   batteryFill.setFillColor(sf::Color::White);
-  window.draw(batteryFill);
+  submit(window, batteryFill);
 
   sf::RectangleShape batteryTip({4.f, 10.f});
   batteryTip.setPosition({1040.f, 29.f});
   batteryTip.setFillColor(sf::Color::White);
-  window.draw(batteryTip);
+  submit(window, batteryTip);
 
-  sf::Text clockText(font_, dateTimeStream.str(), 24);
+  sf::Text& clockText = cachedText(clockString_, 24);
   clockText.setFillColor(sf::Color::White);
   sf::FloatRect clockBounds = clockText.getLocalBounds();
   clockText.setPosition({1260.f - clockBounds.size.x, 20.f});
-  window.draw(clockText);
+  submit(window, clockText);
 
   if (categories_.empty()) {
-    sf::Text emptyText(font_, "No categories loaded", 32);
+    sf::Text& emptyText = cachedText("No categories loaded", 32);
     emptyText.setFillColor(sf::Color::White);
     emptyText.setPosition({500.f, 360.f});
-    window.draw(emptyText);
+    submit(window, emptyText);
+    textCache_.endFrame();
     return;
   }
 
@@ -987,11 +1306,13 @@ void Menu::draw(sf::RenderWindow& window) {
           
           if (selectedItem.type == "psp_iso" || selectedItem.type == "psp_eboot") {
               // 1) Background wallpaper (Fullscreen - Cover Mode)
-              if (selectedItem.hasPreviewBg && selectedItem.previewBgSprite) {
-                  sf::Sprite bg = *selectedItem.previewBgSprite;
+              // PIC1 is requested by refreshResidencyWindow() once the cursor settles, so only look it up here.
+              // Until it fades in fully, the stretched ICON0 stands in as a low-res placeholder.
+              auto drawWallpaper = [&](const sf::Texture& tex, float alpha) {
+                  sf::Sprite bg(tex);
                   
                   sf::Vector2u windowSize = window.getSize();
-                  auto texSize = selectedItem.previewBgTexture.getSize();
+                  auto texSize = tex.getSize();
                   
                   // Calculate scale to COVER the screen (max of X and Y scales)
                   // This ensures the image fills the entire screen without distortion
@@ -1005,17 +1326,28 @@ void Menu::draw(sf::RenderWindow& window) {
                   bg.setOrigin({texSize.x / 2.f, texSize.y / 2.f});
                   bg.setPosition({windowSize.x / 2.f, windowSize.y / 2.f});
                   
-                  bg.setColor(sf::Color(255, 255, 255, static_cast<std::uint8_t>(std::min(255.f, previewAlpha_))));
-                  window.draw(bg);
+                  bg.setColor(sf::Color(255, 255, 255, static_cast<std::uint8_t>(std::min(255.f, alpha))));
+                  submit(window, bg);
+              };
+              const sf::Texture* bgTex = artCache_.find(selectedItem.previewBgPath);
+              if (previewBgAlpha_ < 255.f) {
+                  if (const sf::Texture* placeholder = artCache_.find(selectedItem.previewImagePath)) {
+                      drawWallpaper(*placeholder, std::min(previewAlpha_, 160.f));
+                  }
+              }
+              if (bgTex) {
+                  drawWallpaper(*bgTex, previewBgAlpha_);
               }
 
-              // 2) Preview “video window”
-              if (selectedItem.hasPreview) {
-                  sf::Sprite preview = *selectedItem.previewSprite;
+              // 2) Preview “video window”: ICON1 once it is playing, ICON0 until then
+              const sf::Texture* previewTex = previewVideoFrame_ ? &previewVideoTexture_
+                                                                 : artCache_.get(selectedItem.previewImagePath);
+              if (previewTex) {
+                  sf::Sprite preview(*previewTex);
 
                   float targetW = 320.f;
                   float targetH = 180.f;
-                  auto texSize = selectedItem.previewTexture.getSize();
+                  auto texSize = previewTex->getSize();
                   float scaleX = targetW / texSize.x;
                   float scaleY = targetH / texSize.y;
                   float scale  = std::min(scaleX, scaleY);
@@ -1033,24 +1365,24 @@ void Menu::draw(sf::RenderWindow& window) {
                   sf::RectangleShape shadow({targetW + 12.f, targetH + 12.f});
                   shadow.setPosition({px - 6.f + 4.f, py - 6.f + 4.f});
                   shadow.setFillColor(sf::Color(0, 0, 0, static_cast<std::uint8_t>(std::min(150.f, previewAlpha_))));
-                  window.draw(shadow);
+                  submit(window, shadow);
 
                   // white border
                   sf::RectangleShape frame({targetW + 8.f, targetH + 8.f});
                   frame.setPosition({px - 4.f, py - 4.f});
                   frame.setFillColor(sf::Color(230, 230, 230, static_cast<std::uint8_t>(std::min(230.f, previewAlpha_))));
-                  window.draw(frame);
+                  submit(window, frame);
 
-                  window.draw(preview);
+                  submit(window, preview);
               }
 
               // 3) Big cover art
-              if (selectedItem.hasCoverArt) {
-                  sf::Sprite cover = *selectedItem.coverArtSprite;
+              if (const sf::Texture* coverTex = artCache_.find(selectedItem.coverArtPath)) {
+                  sf::Sprite cover(*coverTex);
 
                   float targetW = 200.f; // Slightly smaller to fit better
                   float targetH = 320.f;
-                  auto texSize = selectedItem.coverArtTexture.getSize();
+                  auto texSize = coverTex->getSize();
                   float scaleX = targetW / texSize.x;
                   float scaleY = targetH / texSize.y;
                   float scale  = std::min(scaleX, scaleY);
@@ -1061,26 +1393,28 @@ void Menu::draw(sf::RenderWindow& window) {
                   float cy = 300.f; 
                   cover.setPosition({cx, cy});
                   
-                  sf::Color fadeColor(255, 255, 255, static_cast<std::uint8_t>(previewAlpha_));
+                  sf::Color fadeColor(255, 255, 255, static_cast<std::uint8_t>(previewBgAlpha_));
                   cover.setColor(fadeColor);
 
                   // small glow
                   sf::RectangleShape glow({targetW + 20.f, targetH + 20.f});
                   glow.setPosition({cx - 10.f, cy - 10.f});
                   glow.setFillColor(sf::Color::Transparent);
-                  glow.setOutlineColor(sf::Color(0, 220, 255, static_cast<std::uint8_t>(std::min(100.f, previewAlpha_))));
+                  glow.setOutlineColor(sf::Color(0, 220, 255, static_cast<std::uint8_t>(std::min(100.f, previewBgAlpha_))));
                   glow.setOutlineThickness(4.f);
-                  window.draw(glow);
+                  submit(window, glow);
 
-                  window.draw(cover);
+                  submit(window, cover);
               }
           }
       }
   }
 
   // 3. Category icons (Parallax Scroll)
+  // Icons are collected into one batch and drawn after the loop; labels are drawn as we go
+  categoryIconBatch_.clear();
   for (size_t i = 0; i < categories_.size(); ++i) {
-    auto& cat = categories_[i];
+    const auto& cat = categories_[i];
     sf::Vector2f pos = getCategoryIconPosition(i);
 
     // Skip if off-screen to save performance
@@ -1095,30 +1429,26 @@ void Menu::draw(sf::RenderWindow& window) {
 
     bool isSelected = (i == currentCategoryIndex_);
     
-    if (cat.iconSprite.has_value()) {
+    if (cat.iconRegion) {
+      sf::Vector2f texSize(cat.iconRegion->rect.size);
       float targetSize = CATEGORY_ICON_SIZE + (CATEGORY_ICON_SIZE_SELECTED - CATEGORY_ICON_SIZE) * scaleRatio;
-      float scale = targetSize / cat.iconTex.getSize().x;
+      float scale = targetSize / texSize.x;
       
       // Add subtle pulse to selected
       if (isSelected) {
-        scale *= 1.0f + 0.05f * std::sin(categoryScaleAnim_);
+        scale *= 1.0f + 0.05f * pulseStrength_ * std::sin(categoryScaleAnim_);
       }
 
-      cat.iconSprite->setPosition(pos);
-      cat.iconSprite->setScale({scale, scale});
-      
       // Fade out distant icons
       sf::Color iconColor = sf::Color::White;
       iconColor.a = static_cast<std::uint8_t>(50 + 205 * scaleRatio);
-      cat.iconSprite->setColor(iconColor);
-      
-      window.draw(*cat.iconSprite);
+      categoryIconBatch_.add(*cat.iconRegion, pos, texSize * scale, iconColor);
     }
 
     // Category label
     // Only show label if it's close to center or selected
     if (scaleRatio > 0.5f) {
-        sf::Text catLabel(font_, cat.label, static_cast<unsigned int>(16 + 8 * scaleRatio));
+        sf::Text& catLabel = scaledText(cat.label, 16.f + 8.f * scaleRatio);
         
         sf::Color labelColor = isSelected ? sf::Color::White : sf::Color(180, 180, 180);
         labelColor.a = static_cast<std::uint8_t>(255 * scaleRatio);
@@ -1131,54 +1461,64 @@ void Menu::draw(sf::RenderWindow& window) {
         float yOffset = (CATEGORY_ICON_SIZE + (CATEGORY_ICON_SIZE_SELECTED - CATEGORY_ICON_SIZE) * scaleRatio) / 2.f;
         catLabel.setPosition({pos.x, pos.y + yOffset + 20.f});
         
-        window.draw(catLabel);
+        submit(window, catLabel);
     }
   }
+  drawCalls_ += categoryIconBatch_.draw(window);
 
   // 4. Item list for current category
   const auto& currentCat = categories_[currentCategoryIndex_];
   
   if (currentCat.items.empty()) {
-    sf::Text emptyText(font_, "No items in this category", 24);
+    sf::Text& emptyText = cachedText("No items in this category", 24);
     emptyText.setFillColor(sf::Color(150, 150, 150));
     emptyText.setPosition({400.f, ITEM_LIST_START_Y + 50.f});
-    window.draw(emptyText);
+    submit(window, emptyText);
   } else {
     // Draw items with smooth scrolling
-    for (size_t i = 0; i < currentCat.items.size(); ++i) {
+    // Only rows that intersect the screen are touched, however long the list is
+    size_t firstVisible = 0;
+    size_t lastVisible = 0;
+    visibleItemRange(currentCat.items.size(), firstVisible, lastVisible);
+
+    // Row icons go into one batch drawn before the labels, so each atlas page costs one draw call
+    itemIconBatch_.clear();
+    for (size_t i = firstVisible; i < lastVisible; ++i) {
+      const auto& item = currentCat.items[i];
+      if (!item.iconRegion) continue;
+      bool isSelected = (i == currentItemIndex_);
+      float yPos = ITEM_LIST_START_Y + i * ITEM_ROW_HEIGHT + itemListOffset_;
+      sf::Vector2f texSize(item.iconRegion->rect.size);
+      float iconSize = isSelected ? 28.f : 24.f;
+      itemIconBatch_.add(*item.iconRegion, {260.f, yPos + ITEM_ROW_HEIGHT / 2.f}, texSize * (iconSize / texSize.x));
+    }
+
+    // The selection highlight sits underneath the icons
+    {
+      float yPos = ITEM_LIST_START_Y + currentItemIndex_ * ITEM_ROW_HEIGHT + itemListOffset_;
+      sf::RectangleShape highlight({500.f, ITEM_ROW_HEIGHT - 4.f});
+      highlight.setPosition({250.f, yPos});
+      highlight.setFillColor(sf::Color(255, 255, 255, 30));
+      highlight.setOutlineColor(sf::Color(0, 255, 255, 150));
+      highlight.setOutlineThickness(2.f);
+      submit(window, highlight);
+    }
+    drawCalls_ += itemIconBatch_.draw(window);
+
+    for (size_t i = firstVisible; i < lastVisible; ++i) {
       auto& item = currentCat.items[i];
       bool isSelected = (i == currentItemIndex_);
       
       float yPos = ITEM_LIST_START_Y + i * ITEM_ROW_HEIGHT + itemListOffset_;
-      
-      // Selection highlight
-      if (isSelected) {
-        sf::RectangleShape highlight({500.f, ITEM_ROW_HEIGHT - 4.f});
-        highlight.setPosition({250.f, yPos});
-        highlight.setFillColor(sf::Color(255, 255, 255, 30));
-        highlight.setOutlineColor(sf::Color(0, 255, 255, 150));
-        highlight.setOutlineThickness(2.f);
-        window.draw(highlight);
-      }
 
-      // Item icon (if available)
-      float textXPos = 270.f;
-      if (item.iconSprite.has_value()) {
-        float iconSize = isSelected ? 28.f : 24.f;
-        float iconScale = iconSize / item.iconTex.getSize().x;
-        sf::Sprite iconSprite(item.iconTex);
-        iconSprite.setScale({iconScale, iconScale});
-        iconSprite.setPosition({260.f, yPos + ITEM_ROW_HEIGHT / 2.f});
-        iconSprite.setOrigin({item.iconTex.getSize().x / 2.f, item.iconTex.getSize().y / 2.f});
-        window.draw(iconSprite);
-        textXPos = 295.f; // Shift text to the right to make room for icon
-      }
+      // Shift text to the right to make room for icon
+      float textXPos = item.iconRegion ? 295.f : 270.f;
       
       // Item text
-      sf::Text itemText(font_, item.label, isSelected ? 22 : 18);
+      sf::Text& itemText = scaledText(item.label, isSelected ? 22.f : 18.f);
       itemText.setFillColor(isSelected ? sf::Color::White : sf::Color(200, 200, 200));
       itemText.setPosition({textXPos, yPos + 8.f});
-      window.draw(itemText);
+      submit(window, itemText);
     }
   }
 
@@ -1196,37 +1536,508 @@ void Menu::draw(sf::RenderWindow& window) {
     }
 
     // Selected item label
-    sf::Text itemTitleText(font_, selectedItem.label, 28);
+    sf::Text& itemTitleText = cachedText(selectedItem.label, 28);
     itemTitleText.setFillColor(sf::Color::White);
     itemTitleText.setPosition({infoPanelX, infoPanelY});
-    window.draw(itemTitleText);
+    submit(window, itemTitleText);
 
     // Item type - show current setting for toggle_time_format
     std::string typeDisplay = getItemTypeDisplay(selectedItem.type);
     if (selectedItem.type == "toggle_time_format" && userProfile_) {
       typeDisplay = userProfile_->getUse24HourFormat() ? "Currently: 24-Hour" : "Currently: 12-Hour";
     }
-    sf::Text itemTypeText(font_, typeDisplay, 18);
+    sf::Text& itemTypeText = cachedText(typeDisplay, 18);
     itemTypeText.setFillColor(sf::Color(180, 180, 180));
     itemTypeText.setPosition({infoPanelX, infoPanelY + 40.f});
-    window.draw(itemTypeText);
+    submit(window, itemTypeText);
 
     // Path (truncated if too long)
     std::string pathDisplay = selectedItem.path;
     if (pathDisplay.length() > 40) {
       pathDisplay = "..." + pathDisplay.substr(pathDisplay.length() - 37);
     }
-    sf::Text itemPathText(font_, pathDisplay, 14);
+    sf::Text& itemPathText = cachedText(pathDisplay, 14);
     itemPathText.setFillColor(sf::Color(120, 120, 120));
     itemPathText.setPosition({infoPanelX, infoPanelY + 70.f});
-    window.draw(itemPathText);
+    submit(window, itemPathText);
   }
 
+  if (searchActive_) drawSearchOverlay(window);
+
   // 6. Bottom control hints
-  sf::Text hintsText(font_, "Left/Right: Category  |  Up/Down: Select  |  Enter: Launch  |  Esc: Exit", 16);
+  std::string hints = "Left/Right: Category  |  Up/Down: Select  |  Enter: Launch  |  /: Search  |  Esc: Exit";
+  if (searchActive_) {
+    hints = "Type to search  |  Up/Down: Select  |  Enter: Go to game  |  Esc: Close";
+  } else if (currentCategoryIndex_ == gamesCategoryIndex_) {
+    hints = "Left/Right: Category  |  Up/Down: Select  |  Enter: Launch  |  /: Search  |  Tab: Sort (" +
+            std::string(SORT_ORDER_NAMES[static_cast<size_t>(sortOrder_)]) + ")";
+  }
+  sf::Text& hintsText = cachedText(hints, 16);
   hintsText.setFillColor(sf::Color(150, 150, 150));
   hintsText.setPosition({30.f, 680.f});
-  window.draw(hintsText);
+  submit(window, hintsText);
+
+  textCache_.endFrame();
+  drawCallSampler_.add(static_cast<double>(drawCalls_));
+  drawTimeSampler_.add(drawTimer_.getElapsedTime().asMicroseconds() / 1000.0);
+}
+
+void Menu::submit(sf::RenderTarget& target, const sf::Drawable& drawable) {
+  target.draw(drawable);
+  ++drawCalls_;
+}
+
+sf::Text& Menu::cachedText(const std::string& string, unsigned int characterSize) {
+  return textCache_.get(font_, string, characterSize);
+}
+
+sf::Text& Menu::scaledText(const std::string& string, float pixelSize) {
+  return textCache_.getScaled(font_, string, pixelSize);
+}
+
+void Menu::warmGlyphCache() {
+  if (!fontLoaded_) return;
+
+  // Printable ASCII covers the clock, hints and info panel; labels may add accented characters.
+  // Collected as a set, so thousands of labels add only the characters not seen yet
+  std::set<char32_t> unique;
+  for (char32_t c = 32; c < 127; ++c) {
+    unique.insert(c);
+  }
+  for (const auto& cat : categories_) {
+    const sf::String label(cat.label);
+    unique.insert(label.begin(), label.end());
+    for (const auto& item : cat.items) {
+      const sf::String itemLabel(item.label);
+      unique.insert(itemLabel.begin(), itemLabel.end());
+    }
+  }
+  sf::String characters;
+  for (char32_t c : unique) {
+    characters += c;
+  }
+
+  // Fixed sizes used by draw() plus the quantized sizes behind scaledText()
+  TextCache::warmGlyphs(font_, characters, {14, 16, 18, 24, 28, 32});
+}
+
+void Menu::refreshHeaderStrings() {
+  const std::time_t now = std::time(nullptr);
+  const long long minute = static_cast<long long>(now) / 60;
+  int flags = 0;
+  std::string userName;
+  if (userProfile_) {
+    flags = (userProfile_->getShowDate() ? 1 : 0) | (userProfile_->getShowClock() ? 2 : 0) |
+            (userProfile_->getUse24HourFormat() ? 4 : 0);
+    userName = userProfile_->getUserName();
+  }
+  if (minute == clockMinute_ && flags == clockFlags_ && userName == clockUserName_) return;
+  clockMinute_ = minute;
+  clockFlags_ = flags;
+  clockUserName_ = userName;
+
+  titleString_ = userName.empty() ? "PSPV2" : "Welcome, " + userName;
+
+  // Date and Time (if enabled in profile)
+  std::tm* localTime = std::localtime(&now);
+  
+  std::ostringstream dateTimeStream;
+  
+  // Show date if enabled
+  if (userProfile_ && userProfile_->getShowDate()) {
+    dateTimeStream << std::setfill('0') << std::setw(2) << (localTime->tm_mon + 1) << "/"
+                   << std::setfill('0') << std::setw(2) << localTime->tm_mday << "/"
+                   << (localTime->tm_year + 1900) << "  ";
+  }
+  
+  // Show time if enabled
+  if (userProfile_ && userProfile_->getShowClock()) {
+    if (userProfile_->getUse24HourFormat()) {
+      // 24-hour format
+      dateTimeStream << std::setfill('0') << std::setw(2) << localTime->tm_hour << ":"
+                     << std::setfill('0') << std::setw(2) << localTime->tm_min;
+    } else {
+      // 12-hour format with AM/PM
+      int hour12 = localTime->tm_hour % 12;
+      if (hour12 == 0) hour12 = 12; // Convert 0 to 12
+      dateTimeStream << hour12 << ":"
+                     << std::setfill('0') << std::setw(2) << localTime->tm_min << " "
+                     << (localTime->tm_hour < 12 ? "AM" : "PM");
+    }
+  }
+  clockString_ = dateTimeStream.str();
+}
+
+void Menu::addSyntheticItems(size_t count) {
+  if (count == 0) return;
+  for (auto& cat : categories_) {
+    if (cat.id != "games") continue;
+    for (size_t i = 0; i < count; ++i) {
+      MenuItem item;
+      item.label = "Synthetic Game " + std::to_string(i + 1);
+      item.path = "synthetic/" + std::to_string(i + 1) + ".iso";
+      item.type = "synthetic";
+      cat.items.push_back(std::move(item));
+    }
+    std::cout << "[Perf] Added " << count << " synthetic items to " << cat.label << "\n";
+    return;
+  }
+}
+
+void Menu::rebuildSearchIndex() {
+  searchIndex_.clear();
+  if (gamesCategoryIndex_ >= categories_.size()) return;
+
+  // Documents are in scan order, so a result's index is an item's scanIndex whatever the sort
+  std::vector<SearchIndex::Document> documents;
+  documents.reserve(categories_[gamesCategoryIndex_].items.size());
+  for (const auto& item : categories_[gamesCategoryIndex_].items) {
+    documents.push_back({item.label, item.discId});
+  }
+
+  // The saved index is reused as long as the scan produced exactly the same titles in the same order
+  sf::Clock timer;
+  const std::string indexPath = "assets/previews/search_index.bin";
+  const std::uint64_t fingerprint = SearchIndex::fingerprint(documents);
+  if (searchIndex_.load(indexPath, fingerprint)) {
+    if (perf::enabled()) {
+      std::cout << "[Perf] Loaded search index for " << documents.size() << " titles in "
+                << timer.getElapsedTime().asMicroseconds() / 1000.0 << " ms\n";
+    }
+    return;
+  }
+
+  searchIndex_.build(documents);
+  if (perf::enabled()) {
+    std::cout << "[Perf] Built search index for " << documents.size() << " titles in "
+              << timer.getElapsedTime().asMicroseconds() / 1000.0 << " ms\n";
+  }
+  std::error_code ec;
+  std::filesystem::create_directories("assets/previews", ec);
+  searchIndex_.save(indexPath, fingerprint);
+}
+
+void Menu::buildSortOrders() {
+  for (auto& permutation : sortPermutations_) permutation.clear();
+  gamePositions_.clear();
+  if (gamesCategoryIndex_ >= categories_.size()) return;
+
+  auto& items = categories_[gamesCategoryIndex_].items;
+  const size_t count = items.size();
+  gamePositions_.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    items[i].scanIndex = i;
+    items[i].collationKey = makeCollationKey(items[i].label);
+    gamePositions_[i] = i;
+  }
+
+  // The only string comparisons: ranking the titles once. Every other order is a stable sort of
+  // the title order on an integer key, so ties stay alphabetical.
+  auto& byTitle = sortPermutations_[static_cast<size_t>(SortOrder::Title)];
+  byTitle.resize(count);
+  std::iota(byTitle.begin(), byTitle.end(), size_t{0});
+  std::stable_sort(byTitle.begin(), byTitle.end(), [&items](size_t a, size_t b) {
+    return items[a].collationKey < items[b].collationKey;
+  });
+
+  auto& bySize = sortPermutations_[static_cast<size_t>(SortOrder::Size)];
+  bySize = byTitle;
+  std::stable_sort(bySize.begin(), bySize.end(), [&items](size_t a, size_t b) {
+    return items[a].sizeBytes > items[b].sizeBytes;
+  });
+
+  auto& byRegion = sortPermutations_[static_cast<size_t>(SortOrder::Region)];
+  byRegion = byTitle;
+  std::stable_sort(byRegion.begin(), byRegion.end(), [&items](size_t a, size_t b) {
+    return regionRank(items[a].discId) < regionRank(items[b].discId);
+  });
+
+  buildHistoryOrders();
+}
+
+void Menu::buildHistoryOrders() {
+  if (playHistory_) historyRevision_ = playHistory_->revision();
+  if (gamesCategoryIndex_ >= categories_.size()) return;
+  const auto& items = categories_[gamesCategoryIndex_].items;
+  const auto& byTitle = sortPermutations_[static_cast<size_t>(SortOrder::Title)];
+  if (byTitle.size() != items.size()) return;
+
+  // Look the history up once per item, by scan index, rather than inside the comparator
+  std::vector<std::int64_t> lastPlayed(items.size(), 0);
+  std::vector<std::int64_t> playSeconds(items.size(), 0);
+  if (playHistory_) {
+    for (const auto& item : items) {
+      if (const PlayHistory::Entry* entry = playHistory_->find(item.path)) {
+        lastPlayed[item.scanIndex] = entry->lastPlayed;
+        playSeconds[item.scanIndex] = entry->playSeconds;
+      }
+    }
+  }
+
+  auto& byLastPlayed = sortPermutations_[static_cast<size_t>(SortOrder::LastPlayed)];
+  byLastPlayed = byTitle;
+  std::stable_sort(byLastPlayed.begin(), byLastPlayed.end(), [&lastPlayed](size_t a, size_t b) {
+    return lastPlayed[a] > lastPlayed[b];
+  });
+
+  auto& byPlayTime = sortPermutations_[static_cast<size_t>(SortOrder::PlayTime)];
+  byPlayTime = byTitle;
+  std::stable_sort(byPlayTime.begin(), byPlayTime.end(), [&playSeconds](size_t a, size_t b) {
+    return playSeconds[a] > playSeconds[b];
+  });
+}
+
+void Menu::applySortOrder(SortOrder order) {
+  sortOrder_ = order;
+  if (gamesCategoryIndex_ >= categories_.size()) return;
+  auto& items = categories_[gamesCategoryIndex_].items;
+  const auto& permutation = sortPermutations_[static_cast<size_t>(order)];
+  if (permutation.size() != items.size()) return;
+
+  const bool onGames = currentCategoryIndex_ == gamesCategoryIndex_ && currentItemIndex_ < items.size();
+  const size_t selectedScanIndex = onGames ? items[currentItemIndex_].scanIndex : 0;
+
+  // One pass of moves; nothing is compared
+  std::vector<MenuItem> sorted;
+  sorted.reserve(items.size());
+  for (size_t scanIndex : permutation) {
+    sorted.push_back(std::move(items[gamePositions_[scanIndex]]));
+  }
+  items = std::move(sorted);
+  for (size_t i = 0; i < items.size(); ++i) {
+    gamePositions_[items[i].scanIndex] = i;
+  }
+
+  letterStarts_.fill(static_cast<size_t>(-1));
+  if (order == SortOrder::Title) {
+    for (size_t i = items.size(); i-- > 0;) {
+      const char letter = letterGroup(items[i]);
+      letterStarts_[letter == '#' ? 0 : static_cast<size_t>(letter - 'A') + 1] = i;
+    }
+  }
+
+  if (onGames) {
+    // Same game stays selected; the list snaps around it instead of scrolling there
+    currentItemIndex_ = lastItemIndex_ = gamePositions_[selectedScanIndex];
+    itemListOffset_ = targetItemListOffset_ = -static_cast<float>(currentItemIndex_) * ITEM_ROW_HEIGHT;
+    refreshResidencyWindow();
+  }
+}
+
+void Menu::cycleSortOrder() {
+  if (currentCategoryIndex_ != gamesCategoryIndex_ || gamesCategoryIndex_ >= categories_.size()) {
+    soundBank_.playError();
+    return;
+  }
+  const size_t next = (static_cast<size_t>(sortOrder_) + 1) % static_cast<size_t>(SortOrder::Count);
+  applySortOrder(static_cast<SortOrder>(next));
+  soundBank_.playOption();
+}
+
+char Menu::groupOf(const MenuItem& item) const {
+  if (currentCategoryIndex_ != gamesCategoryIndex_) return letterGroup(item);
+  switch (sortOrder_) {
+    case SortOrder::Title: return letterGroup(item);
+    case SortOrder::Region: return static_cast<char>('0' + regionRank(item.discId));
+    default: return 0;
+  }
+}
+
+void Menu::openSearch() {
+  if (gamesCategoryIndex_ >= categories_.size() || categories_[gamesCategoryIndex_].items.empty()) {
+    soundBank_.playError();
+    return;
+  }
+  searchActive_ = true;
+  searchQuery_.clear();
+  searchResults_.clear();
+  searchCursor_ = 0;
+  navInput_.reset();
+  soundBank_.playOption();
+}
+
+void Menu::closeSearch() {
+  searchActive_ = false;
+  searchQuery_.clear();
+  searchResults_.clear();
+  navInput_.reset();
+}
+
+void Menu::handleSearchEvent(const sf::Event& event) {
+  if (const auto action = navInput_.handleEvent(event)) {
+    applyNavAction(*action, false);
+  }
+
+  if (const auto* text = event.getIf<sf::Event::TextEntered>()) {
+    // Printable ASCII only; '/' is the key that opened the box and arrives here too
+    if (text->unicode >= 32 && text->unicode < 127 && text->unicode != '/' && searchQuery_.size() < SEARCH_QUERY_MAX) {
+      searchQuery_.push_back(static_cast<char>(text->unicode));
+      runSearch();
+    }
+  } else if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+    if (keyPressed->code == sf::Keyboard::Key::Backspace) {
+      if (!searchQuery_.empty()) {
+        searchQuery_.pop_back();
+        runSearch();
+      }
+    } else if (keyPressed->code == sf::Keyboard::Key::Enter) {
+      acceptSearchResult();
+    } else if (keyPressed->code == sf::Keyboard::Key::Escape) {
+      soundBank_.playCancel();
+      closeSearch();
+    }
+  } else if (const auto* buttonPressed = event.getIf<sf::Event::JoystickButtonPressed>()) {
+    if (buttonPressed->button == 0) {
+      acceptSearchResult();
+    } else if (buttonPressed->button == 1) {
+      soundBank_.playCancel();
+      closeSearch();
+    }
+  }
+}
+
+void Menu::runSearch() {
+  sf::Clock timer;
+  searchResults_ = searchIndex_.search(searchQuery_, SEARCH_RESULTS);
+  searchTimeSampler_.add(timer.getElapsedTime().asMicroseconds() / 1000.0);
+  searchCursor_ = 0;
+}
+
+void Menu::acceptSearchResult() {
+  if (searchResults_.empty()) {
+    soundBank_.playError();
+    return;
+  }
+  const size_t scanIndex = searchResults_[searchCursor_].index;
+  if (gamesCategoryIndex_ < categories_.size() && scanIndex < gamePositions_.size()) {
+    const size_t index = gamePositions_[scanIndex];
+    if (currentCategoryIndex_ != gamesCategoryIndex_) {
+      currentCategoryIndex_ = gamesCategoryIndex_;
+      currentItemIndex_ = 0;
+    }
+    jumpToItem(index);
+  }
+  closeSearch();
+}
+
+void Menu::drawSearchOverlay(sf::RenderTarget& window) {
+  const auto& items = categories_[gamesCategoryIndex_].items;
+  const float panelX = 260.f;
+  const float panelY = 90.f;
+  const float rowHeight = 34.f;
+
+  sf::RectangleShape panel({560.f, 70.f + rowHeight * static_cast<float>(SEARCH_RESULTS)});
+  panel.setPosition({panelX, panelY});
+  panel.setFillColor(sf::Color(0, 0, 0, 200));
+  panel.setOutlineColor(sf::Color(255, 255, 255, 90));
+  panel.setOutlineThickness(1.f);
+  submit(window, panel);
+
+  sf::Text& queryText = cachedText("Search: " + searchQuery_ + "_", 22);
+  queryText.setFillColor(sf::Color::White);
+  queryText.setPosition({panelX + 16.f, panelY + 14.f});
+  submit(window, queryText);
+
+  if (searchResults_.empty()) {
+    sf::Text& emptyText = cachedText(searchQuery_.empty() ? "Type part of a title or disc ID" : "No matches", 18);
+    emptyText.setFillColor(sf::Color(150, 150, 150));
+    emptyText.setPosition({panelX + 16.f, panelY + 60.f});
+    submit(window, emptyText);
+    return;
+  }
+
+  for (size_t i = 0; i < searchResults_.size(); ++i) {
+    const float yPos = panelY + 56.f + rowHeight * static_cast<float>(i);
+    const bool isSelected = i == searchCursor_;
+    if (isSelected) {
+      sf::RectangleShape highlight({548.f, rowHeight - 2.f});
+      highlight.setPosition({panelX + 6.f, yPos});
+      highlight.setFillColor(sf::Color(255, 255, 255, 50));
+      submit(window, highlight);
+    }
+    sf::Text& resultText = cachedText(items[gamePositions_[searchResults_[i].index]].label, 18);
+    resultText.setFillColor(isSelected ? sf::Color::White : sf::Color(200, 200, 200));
+    resultText.setPosition({panelX + 16.f, yPos + 5.f});
+    submit(window, resultText);
+  }
+}
+
+void Menu::suspend() {
+  stopPreviewPlayback();
+  // Only ICON0/PIC1 textures live in artCache_; the icon atlas, glyph pages and wallpaper stay resident
+  artCache_.clear();
+  std::cout << "[Menu] Suspended, released preview art\n";
+}
+
+void Menu::resume() {
+  // The first frame draws from the atlas and retained text straight away; previews fade in as they decode
+  lastCategoryIndex_ = static_cast<size_t>(-1);
+  lastItemIndex_ = static_cast<size_t>(-1);
+  inputIdleTime_ = 0.f;
+  navInput_.reset();
+  closeSearch();
+  animating_ = true;
+}
+
+void Menu::saveUiState(const std::string& path) const {
+  if (categories_.empty()) return;
+  const auto& cat = categories_[currentCategoryIndex_];
+
+  json j;
+  j["category"] = cat.id;
+  j["item_index"] = currentItemIndex_;
+  j["sort_order"] = SORT_ORDER_IDS[static_cast<size_t>(sortOrder_)];
+  if (currentItemIndex_ < cat.items.size()) {
+    j["item_path"] = cat.items[currentItemIndex_].path;
+  }
+
+  std::ofstream file(path);
+  if (!file) {
+    std::cerr << "Warning: failed to write UI state to " << path << "\n";
+    return;
+  }
+  file << j.dump(2);
+}
+
+void Menu::restoreUiState(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) return;
+
+  try {
+    json j;
+    file >> j;
+    // Sort first, so the saved item is looked up in the order it was saved in
+    const std::string sortId = j.value("sort_order", std::string(SORT_ORDER_IDS[0]));
+    for (size_t order = 0; order < static_cast<size_t>(SortOrder::Count); ++order) {
+      if (sortId == SORT_ORDER_IDS[order] && static_cast<SortOrder>(order) != sortOrder_) {
+        applySortOrder(static_cast<SortOrder>(order));
+      }
+    }
+    const std::string categoryId = j.value("category", std::string());
+    for (size_t c = 0; c < categories_.size(); ++c) {
+      if (categories_[c].id != categoryId) continue;
+      const auto& items = categories_[c].items;
+
+      // Prefer the item's path; the list may have been rescanned since
+      size_t index = j.value("item_index", static_cast<size_t>(0));
+      const std::string itemPath = j.value("item_path", std::string());
+      for (size_t i = 0; i < items.size(); ++i) {
+        if (!itemPath.empty() && items[i].path == itemPath) {
+          index = i;
+          break;
+        }
+      }
+
+      currentCategoryIndex_ = c;
+      currentItemIndex_ = items.empty() ? 0 : std::min(index, items.size() - 1);
+      // Land in place instead of scrolling there
+      categoryScrollOffset_ = targetCategoryScrollOffset_ = static_cast<float>(currentCategoryIndex_);
+      itemListOffset_ = targetItemListOffset_ = -static_cast<float>(currentItemIndex_) * ITEM_ROW_HEIGHT;
+      return;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Warning: ignoring UI state in " << path << ": " << e.what() << "\n";
+  }
 }
 
 MenuItem Menu::getSelectedItem() const {
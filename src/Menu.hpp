@@ -2,10 +2,19 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <optional>
 #include <memory>
+#include "TextureAtlas.hpp"
+#include "TextureCache.hpp"
+#include "TextCache.hpp"
+#include "InputRepeater.hpp"
+#include "PerfStats.hpp"
+#include "SearchIndex.hpp"
+#include "VideoPipeReader.hpp"
 
 class UiSoundBank;
 
@@ -13,27 +22,19 @@ struct MenuItem {
   std::string label;
   std::string path;
   std::string type;
+  std::string discId;           // From PARAM.SFO for games; searchable alongside the label
+  std::uintmax_t sizeBytes = 0; // ROM file size, for the size sort
+  std::string collationKey;     // Title folded for natural ordering; computed once at scan
+  size_t scanIndex = 0;         // Position in the Games list as scanned, before any sort
   std::string iconFilename;
-  sf::Texture iconTex;
-  std::optional<sf::Sprite> iconSprite;
+  std::optional<AtlasRegion> iconRegion; // Packed list icon (config icon or ICON0 thumbnail)
 
-  // Preview fields
+  // Preview fields (textures are loaded on demand through Menu's TextureCache)
   std::string previewImagePath; // Used for preview_card
   std::string previewBgPath;
   std::string coverArtPath;     // NEW: Big cover art
   std::string previewAudioPath;
-
-  sf::Texture previewTexture;
-  std::optional<sf::Sprite> previewSprite;
-  bool hasPreview = false;
-
-  sf::Texture previewBgTexture;
-  std::optional<sf::Sprite> previewBgSprite;
-  bool hasPreviewBg = false;
-
-  sf::Texture coverArtTexture;
-  std::optional<sf::Sprite> coverArtSprite;
-  bool hasCoverArt = false;
+  std::string previewVideoPath; // ICON1 stream, played in the preview window once the cursor rests
   
   // Audio
   std::shared_ptr<sf::SoundBuffer> previewBuffer;
@@ -44,34 +45,89 @@ struct Category {
   std::string id;
   std::string label;
   std::string iconFilename;
-  sf::Texture iconTex;
-  std::optional<sf::Sprite> iconSprite;
+  std::optional<AtlasRegion> iconRegion;
   std::vector<MenuItem> items;
 };
 
+// Orders the Games category can be listed in (Tab / Triangle cycles)
+enum class SortOrder {
+  Title,      // Natural order, leading "The"/"A"/"An" ignored
+  LastPlayed, // Most recent first, never played last
+  PlayTime,   // Most played first
+  Size,       // Largest first
+  Region,     // US, Europe, Japan, Asia, Korea, then unknown
+  Count
+};
+
 class UserProfile;
+class PlayHistory;
 
 class Menu {
 public:
-  Menu(const std::string& configPath, UiSoundBank& sounds, UserProfile* profile = nullptr);
+  Menu(const std::string& configPath, UiSoundBank& sounds, UserProfile* profile = nullptr,
+       const PlayHistory* history = nullptr);
 
   void handleEvent(const sf::Event& event);
   void update(float dt);
-  void draw(sf::RenderWindow& window);
+  void draw(sf::RenderTarget& window); // Also used to render the backdrop snapshot behind overlays
 
   bool wantsToLaunch() const { return launchRequested_; }
   MenuItem getSelectedItem() const;
   void resetLaunchRequest() { launchRequested_ = false; }
   void reloadBackground();
-  void stopPreviewAudio() { if (previewSoundPlayer_) previewSoundPlayer_->stop(); }
+  // Shows a background rendered elsewhere (the theme creator's) until reloadBackground() picks a file again
+  void setCustomBackground(std::shared_ptr<const sf::Texture> texture);
+  // Stops the selected game's ICON1 video and SND0; they start again once the cursor rests
+  void stopPreviewPlayback();
+  // False once every animation has settled and no art is loading, so the caller can stop redrawing
+  bool isAnimating() const { return animating_; }
+
+  // Background mode: drop preview art and audio while a game runs, then come back warm
+  void suspend();
+  void resume();
+
+  // Small snapshot of where the cursor is, so a relaunch or return from a game lands on the same item
+  void saveUiState(const std::string& path) const;
+  void restoreUiState(const std::string& path);
 
 private:
   void loadFromFile(const std::string& configPath);
+  void fitBackgroundSprite(const sf::Texture& texture);
   void loadAssets();
   void loadSettings(const std::string& settingsPath);
   void scanRomsFolder();
   std::string getItemTypeDisplay(const std::string& type) const;
   sf::Vector2f getCategoryIconPosition(size_t index) const;
+  void visibleItemRange(size_t itemCount, size_t& first, size_t& last) const;
+  void refreshResidencyWindow();
+  void noteItemStep(int direction);
+  static InputRepeater::Config itemNavigationConfig();
+  void applyNavAction(NavAction action, bool repeated);
+  void changeCategory(int direction);
+  void moveItemCursor(int direction, bool repeated);
+  void jumpToItem(size_t index);
+  void jumpToLetter(char letter);
+  void jumpToLetterGroup(int direction);
+  void submit(sf::RenderTarget& target, const sf::Drawable& drawable);
+  sf::Text& cachedText(const std::string& string, unsigned int characterSize);
+  sf::Text& scaledText(const std::string& string, float pixelSize);
+  void warmGlyphCache();
+  void refreshHeaderStrings();
+  void addSyntheticItems(size_t count);
+  void rebuildSearchIndex();
+  void buildSortOrders();
+  void buildHistoryOrders();
+  void applySortOrder(SortOrder order);
+  void cycleSortOrder();
+  char groupOf(const MenuItem& item) const;
+  void openSearch();
+  void closeSearch();
+  void handleSearchEvent(const sf::Event& event);
+  void runSearch();
+  void acceptSearchResult();
+  void drawSearchOverlay(sf::RenderTarget& window);
+  void startPreviewPlayback();
+  void updatePreviewVideo(float dt);
 
   std::vector<Category> categories_;
   size_t currentCategoryIndex_{0};
@@ -92,6 +148,10 @@ private:
   float targetBgOffsetX_{0.f};
   float targetBgOffsetY_{0.f};
   float previewAlpha_{0.f};
+  float previewBgAlpha_{0.f}; // PIC1 fades in over the low-res placeholder once decoded
+  float inputIdleTime_{0.f};
+  float pulseStrength_{1.f};  // Selected category pulse; eases out after PULSE_IDLE_SECONDS without input
+  bool animating_{true};
 
   // Rendering
   sf::Font font_;
@@ -99,11 +159,74 @@ private:
   sf::Texture bgTexture_;
   std::optional<sf::Sprite> bgSprite_;
   bool bgLoaded_{false};
+  std::string bgLoadedPath_;       // File behind bgTexture_ and its mtime; reloading it unchanged is skipped
+  std::int64_t bgLoadedMtime_{0};
+  std::shared_ptr<const sf::Texture> customBgTexture_; // Shared with the theme creator, which doesn't redraw it while shown
+
+  // Icons for categories and items share a few atlas pages and are drawn in one batch per page
+  TextureAtlas iconAtlas_;
+  AtlasBatch categoryIconBatch_{iconAtlas_};
+  AtlasBatch itemIconBatch_{iconAtlas_};
+  // Preview art is decoded on demand around the cursor and evicted under a budget
+  TextureCache artCache_{256u * 1024u * 1024u};
+  size_t residencyRadius_{20};
+
+  // Item navigation speed, used to prefetch art ahead of the cursor
+  sf::Clock navClock_;
+  float lastStepTime_{-1.f};
+  float scrollVelocity_{0.f}; // Items per second, smoothed
+  int scrollDirection_{0};    // +1 down, -1 up, 0 settled
+  bool fastScrolling_{false}; // Full-size PIC1 decodes are skipped while set
+
+  // Press/repeat/release for arrows, D-pad, stick and shoulder buttons; held Up/Down ramps 5 -> 40 items/s
+  InputRepeater navInput_{itemNavigationConfig()};
+  float lastCursorSoundTime_{-1.f};
+
+  // Type-ahead search over the Games category ('/' opens it); the index is persisted next to the art cache
+  SearchIndex searchIndex_;
+  size_t gamesCategoryIndex_{static_cast<size_t>(-1)};
+  bool searchActive_{false};
+  std::string searchQuery_;
+  std::vector<SearchIndex::Result> searchResults_;
+  size_t searchCursor_{0};
+  perf::Sampler searchTimeSampler_{"Search query time", "ms"};
+
+  // Each order is a precomputed permutation of scan indices, so switching is one O(n) reorder.
+  // Title/size/region are built once at scan; the history orders again when the history changes.
+  SortOrder sortOrder_{SortOrder::Title};
+  std::array<std::vector<size_t>, static_cast<size_t>(SortOrder::Count)> sortPermutations_;
+  std::vector<size_t> gamePositions_;   // Scan index -> current position in the Games list
+  std::array<size_t, 27> letterStarts_{}; // Title order: first position of '#', 'A'..'Z' (or npos)
+  const PlayHistory* playHistory_;
+  unsigned int historyRevision_{0};
+
+  // Labels keep their glyph geometry between frames
+  TextCache textCache_;
+  // Header strings are only reformatted when the minute or the profile settings change
+  std::string titleString_;
+  std::string clockString_;
+  std::string clockUserName_;
+  long long clockMinute_{-1};
+  int clockFlags_{-1};
+
+  size_t drawCalls_{0};
+  perf::Sampler drawCallSampler_{"Menu draw calls/frame", "calls"};
+  perf::Sampler drawTimeSampler_{"Menu::draw time", "ms"};
+  sf::Clock drawTimer_;
 
   // Audio
   UiSoundBank& soundBank_;
   std::optional<sf::Sound> previewSoundPlayer_;
 
+  // ICON1 for the selected game only, decoded by ffmpeg into the reader's frame ring. It and SND0
+  // start once the cursor has rested on an item and are torn down the moment it moves.
+  VideoPipeReader previewVideo_;
+  sf::Texture previewVideoTexture_;
+  bool previewVideoFrame_{false}; // The texture holds a frame of the current item's video
+  double previewVideoClock_{0.0};
+  float selectionRestTime_{0.f};
+  bool previewPlaybackStarted_{false};
+
   // User profile
   UserProfile* userProfile_;
 
@@ -114,4 +237,17 @@ private:
   static constexpr float CATEGORY_Y_POS = 200.f;
   static constexpr float ITEM_LIST_START_Y = 350.f;
   static constexpr float ITEM_ROW_HEIGHT = 40.f;
+  static constexpr unsigned int GAME_ICON_ATLAS_EDGE = 64; // ICON0 thumbnails, 2x the list icon size
+  static constexpr float PREFETCH_HORIZON = 0.3f;   // Seconds of travel to prefetch ahead of the cursor
+  static constexpr float FAST_SCROLL_SPEED = 8.f;   // Items per second
+  static constexpr float SCROLL_SETTLE_TIME = 0.2f; // Seconds without a step before the cursor counts as settled
+  static constexpr float PULSE_IDLE_SECONDS = 10.f;
+  static constexpr size_t PAGE_ITEMS = 8;                 // Rows visible below the cursor
+  static constexpr float CURSOR_SOUND_INTERVAL = 0.06f;   // Repeats faster than this share one tick
+  static constexpr size_t SEARCH_RESULTS = 8;
+  static constexpr size_t SEARCH_QUERY_MAX = 64;
+  static constexpr float PREVIEW_PLAYBACK_DELAY = 0.5f; // Rest on an item this long before ICON1/SND0 play
+  static constexpr unsigned int ICON1_WIDTH = 144;
+  static constexpr unsigned int ICON1_HEIGHT = 80;
+  static constexpr float ICON1_FPS = 30.f;
 };
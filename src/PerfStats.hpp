@@ -0,0 +1,73 @@
+#pragma once
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+
+/**
+ * Opt-in performance counters.
+ * Run with PSPV2_PERF=1 in the environment to print min/avg/max of each
+ * sampler every few seconds; otherwise adding a sample is a cheap no-op.
+ */
+namespace perf {
+
+inline bool enabled() {
+    static const bool on = [] {
+        const char* value = std::getenv("PSPV2_PERF");
+        return value && *value && *value != '0';
+    }();
+    return on;
+}
+
+// Reads a non-negative count from the environment (0 when unset or malformed)
+inline std::size_t envCount(const char* name) {
+    const char* value = std::getenv(name);
+    if (!value || !*value) return 0;
+    char* end = nullptr;
+    const long long parsed = std::strtoll(value, &end, 10);
+    return (end && *end == '\0' && parsed > 0) ? static_cast<std::size_t>(parsed) : 0;
+}
+
+class Sampler {
+public:
+    Sampler(std::string name, std::string unit, float intervalSeconds = 5.f)
+        : name_(std::move(name)), unit_(std::move(unit)), interval_(intervalSeconds) {}
+
+    void add(double value) {
+        if (!enabled()) return;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        ++count_;
+        if (clock_.getElapsedTime().asSeconds() >= interval_) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if (count_ > 0) {
+            std::cout << "[Perf] " << name_ << ": avg " << (sum_ / count_) << " " << unit_
+                      << " | min " << min_ << " | max " << max_ << " (" << count_ << " samples)\n";
+        }
+        sum_ = 0.0;
+        min_ = std::numeric_limits<double>::max();
+        max_ = std::numeric_limits<double>::lowest();
+        count_ = 0;
+        clock_.restart();
+    }
+
+private:
+    std::string name_;
+    std::string unit_;
+    float interval_;
+    sf::Clock clock_;
+    double sum_ = 0.0;
+    double min_ = std::numeric_limits<double>::max();
+    double max_ = std::numeric_limits<double>::lowest();
+    std::size_t count_ = 0;
+};
+
+} // namespace perf
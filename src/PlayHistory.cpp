@@ -0,0 +1,66 @@
+#include "PlayHistory.hpp"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iostream>
+
+using json = nlohmann::json;
+
+bool PlayHistory::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    try {
+        json j;
+        file >> j;
+        entries_.clear();
+        for (const auto& [itemPath, value] : j.items()) {
+            Entry entry;
+            entry.lastPlayed = value.value("last_played", static_cast<std::int64_t>(0));
+            entry.playSeconds = value.value("play_seconds", static_cast<std::int64_t>(0));
+            entries_[itemPath] = entry;
+        }
+        ++revision_;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: ignoring play history in " << path << ": " << e.what() << "\n";
+        return false;
+    }
+}
+
+bool PlayHistory::save(const std::string& path) const {
+    json j = json::object();
+    for (const auto& [itemPath, entry] : entries_) {
+        j[itemPath] = {{"last_played", entry.lastPlayed}, {"play_seconds", entry.playSeconds}};
+    }
+
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Warning: failed to write play history to " << path << "\n";
+        return false;
+    }
+    file << j.dump(2);
+    return true;
+}
+
+void PlayHistory::beginSession(const std::string& itemPath) {
+    if (inSession()) endSession();
+    sessionPath_ = itemPath;
+    sessionStart_ = std::chrono::steady_clock::now();
+
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    entries_[itemPath].lastPlayed = std::chrono::duration_cast<std::chrono::seconds>(now).count();
+    ++revision_;
+}
+
+void PlayHistory::endSession() {
+    if (!inSession()) return;
+    const auto elapsed = std::chrono::steady_clock::now() - sessionStart_;
+    entries_[sessionPath_].playSeconds += std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
+    sessionPath_.clear();
+    ++revision_;
+}
+
+const PlayHistory::Entry* PlayHistory::find(const std::string& itemPath) const {
+    const auto it = entries_.find(itemPath);
+    return it == entries_.end() ? nullptr : &it->second;
+}
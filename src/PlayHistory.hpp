@@ -0,0 +1,35 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * When each game was last played and for how long in total, keyed by the
+ * menu item path. Backs the "last played" and "play time" sort orders.
+ */
+class PlayHistory {
+public:
+    struct Entry {
+        std::int64_t lastPlayed = 0;  // Unix seconds of the last launch, 0 = never
+        std::int64_t playSeconds = 0; // Total time the emulator ran for this game
+    };
+
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    // A session starts when the emulator is launched and ends when it exits or is closed from the quick menu
+    void beginSession(const std::string& itemPath);
+    void endSession();
+    bool inSession() const { return !sessionPath_.empty(); }
+
+    const Entry* find(const std::string& itemPath) const;
+    // Bumped on every change, so views sorted by history know when to re-sort
+    unsigned int revision() const { return revision_; }
+
+private:
+    std::unordered_map<std::string, Entry> entries_;
+    std::string sessionPath_;
+    std::chrono::steady_clock::time_point sessionStart_;
+    unsigned int revision_ = 0;
+};
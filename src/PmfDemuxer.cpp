@@ -0,0 +1,111 @@
+#include "PmfDemuxer.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::uint32_t PSMF_HEADER_BYTES = 0x800;
+constexpr std::uint8_t PACK_START = 0xBA;
+constexpr std::uint8_t SYSTEM_HEADER = 0xBB;
+constexpr std::uint8_t PROGRAM_END = 0xB9;
+
+std::uint32_t readBigEndian32(const std::uint8_t* bytes) {
+    return (static_cast<std::uint32_t>(bytes[0]) << 24) | (static_cast<std::uint32_t>(bytes[1]) << 16) |
+           (static_cast<std::uint32_t>(bytes[2]) << 8) | bytes[3];
+}
+
+} // namespace
+
+bool PmfDemuxer::extractVideo(const std::string& pmfPath, const std::string& outPath) {
+    std::ifstream in(pmfPath, std::ios::binary);
+    std::uint8_t header[16];
+    if (!in.read(reinterpret_cast<char*>(header), sizeof(header)) || std::memcmp(header, "PSMF", 4) != 0) {
+        std::cerr << "PmfDemuxer: " << pmfPath << " is not a PSMF file\n";
+        return false;
+    }
+
+    // The header gives where the program stream starts and how long it is
+    std::uint32_t streamOffset = readBigEndian32(header + 8);
+    const std::uint64_t streamSize = readBigEndian32(header + 12);
+    if (streamOffset < sizeof(header)) streamOffset = PSMF_HEADER_BYTES;
+    in.seekg(streamOffset);
+
+    const std::string tempPath = outPath + ".tmp";
+    std::uint64_t written = 0;
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out || !demux(in, streamSize, out, written) || !out.flush()) {
+            out.close();
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            std::cerr << "PmfDemuxer: no video stream in " << pmfPath << "\n";
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, outPath, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    std::cout << "PmfDemuxer: " << written << " bytes of video from " << pmfPath << "\n";
+    return true;
+}
+
+bool PmfDemuxer::demux(std::istream& in, std::uint64_t streamSize, std::ostream& out, std::uint64_t& written) {
+    std::vector<char> packet;
+    std::uint32_t code = 0xFFFFFFFF;
+    std::uint64_t consumed = 0;
+    while (streamSize == 0 || consumed < streamSize) {
+        // Hunt for the next 00 00 01 xx start code a byte at a time, so padding and junk are skipped
+        const int byte = in.get();
+        if (byte < 0) break;
+        ++consumed;
+        code = (code << 8) | static_cast<std::uint32_t>(byte);
+        if ((code & 0xFFFFFF00) != 0x00000100) continue;
+
+        const std::uint8_t id = static_cast<std::uint8_t>(code);
+        code = 0xFFFFFFFF;
+        if (id == PROGRAM_END) break;
+        if (id == PACK_START) {
+            // MPEG-2 pack header: 10 more bytes, the last of which counts the stuffing after it
+            std::uint8_t pack[10];
+            if (!in.read(reinterpret_cast<char*>(pack), sizeof(pack))) break;
+            if ((pack[0] & 0xC0) == 0x40) {
+                in.ignore(pack[9] & 0x07);
+                consumed += sizeof(pack) + (pack[9] & 0x07);
+            } else {
+                in.seekg(-2, std::ios::cur); // MPEG-1 pack, 8 bytes
+                consumed += sizeof(pack) - 2;
+            }
+            continue;
+        }
+        if (id < SYSTEM_HEADER) continue; // Not a packet start; keep hunting
+
+        // Every other start code is followed by a 16-bit length
+        std::uint8_t lengthBytes[2];
+        if (!in.read(reinterpret_cast<char*>(lengthBytes), 2)) break;
+        const std::size_t length = (lengthBytes[0] << 8) | lengthBytes[1];
+        consumed += 2 + length;
+        if (id != VIDEO_STREAM_ID) {
+            in.ignore(static_cast<std::streamsize>(length));
+            continue;
+        }
+
+        packet.resize(length);
+        if (!in.read(packet.data(), static_cast<std::streamsize>(length))) break;
+        // MPEG-2 PES header: two flag bytes, then its own length
+        if (length < 3 || (static_cast<std::uint8_t>(packet[0]) & 0xC0) != 0x80) continue;
+        const std::size_t payload = 3 + static_cast<std::uint8_t>(packet[2]);
+        if (payload >= length) continue;
+        out.write(packet.data() + payload, static_cast<std::streamsize>(length - payload));
+        written += length - payload;
+    }
+    return written > 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/**
+ * Pulls the H.264 video out of a PSP movie file (ICON1.PMF). A PMF is a
+ * 2 KiB PSMF header followed by an MPEG program stream; the video is PES
+ * stream 0xE0 and carries an Annex B byte stream, which ffmpeg decodes as
+ * raw h264. The file is read in one streaming pass.
+ */
+class PmfDemuxer {
+public:
+    // Writes the video elementary stream of `pmfPath` to `outPath`; false if there was none
+    static bool extractVideo(const std::string& pmfPath, const std::string& outPath);
+
+private:
+    static constexpr std::uint8_t VIDEO_STREAM_ID = 0xE0;
+
+    static bool demux(std::istream& in, std::uint64_t streamSize, std::ostream& out, std::uint64_t& written);
+};
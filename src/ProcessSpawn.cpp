@@ -0,0 +1,202 @@
+#include "ProcessSpawn.hpp"
+#include "ProcessSupervisor.hpp"
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <spawn.h>
+    #include <cstring>
+    extern char** environ;
+#endif
+
+namespace {
+
+long long millisecondsBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count();
+}
+
+#ifdef _WIN32
+
+// Quotes one argument so CommandLineToArgvW (and the MSVC runtime) reads it back unchanged
+std::wstring quoteArgument(const std::wstring& arg) {
+    if (!arg.empty() && arg.find_first_of(L" \t\n\v\"") == std::wstring::npos) {
+        return arg;
+    }
+
+    std::wstring quoted = L"\"";
+    for (auto it = arg.begin();; ++it) {
+        std::size_t backslashes = 0;
+        while (it != arg.end() && *it == L'\\') {
+            ++it;
+            ++backslashes;
+        }
+        if (it == arg.end()) {
+            // Double trailing backslashes so they don't escape the closing quote
+            quoted.append(backslashes * 2, L'\\');
+            break;
+        }
+        if (*it == L'"') {
+            quoted.append(backslashes * 2 + 1, L'\\');
+        } else {
+            quoted.append(backslashes, L'\\');
+        }
+        quoted.push_back(*it);
+    }
+    quoted.push_back(L'"');
+    return quoted;
+}
+
+struct WindowSearch {
+    DWORD pid;
+    bool found;
+};
+
+BOOL CALLBACK checkWindow(HWND hwnd, LPARAM param) {
+    auto* search = reinterpret_cast<WindowSearch*>(param);
+    DWORD owner = 0;
+    GetWindowThreadProcessId(hwnd, &owner);
+    if (owner == search->pid && IsWindowVisible(hwnd)) {
+        search->found = true;
+        return FALSE; // Stop enumerating
+    }
+    return TRUE;
+}
+
+bool hasVisibleWindow(ProcessId pid) {
+    WindowSearch search{pid, false};
+    EnumWindows(&checkWindow, reinterpret_cast<LPARAM>(&search));
+    return search.found;
+}
+
+BOOL CALLBACK restoreWindow(HWND hwnd, LPARAM param) {
+    auto* search = reinterpret_cast<WindowSearch*>(param);
+    DWORD owner = 0;
+    GetWindowThreadProcessId(hwnd, &owner);
+    if (owner == search->pid && IsWindowVisible(hwnd) && !GetWindow(hwnd, GW_OWNER)) {
+        ShowWindow(hwnd, SW_RESTORE);
+        SetForegroundWindow(hwnd);
+        search->found = true;
+    }
+    return TRUE;
+}
+
+#endif
+
+} // namespace
+
+#ifdef _WIN32
+
+std::optional<SpawnedProcess> spawnProcess(const std::vector<std::string>& argv, bool startMinimized) {
+    if (argv.empty()) return std::nullopt;
+
+    // Same narrow->wide conversion std::filesystem uses, so paths built with path::string() round-trip
+    const std::wstring application = std::filesystem::path(argv[0]).wstring();
+    std::wstring commandLine;
+    for (const auto& arg : argv) {
+        if (!commandLine.empty()) commandLine += L' ';
+        commandLine += quoteArgument(std::filesystem::path(arg).wstring());
+    }
+
+    STARTUPINFOW startup{};
+    startup.cb = sizeof(startup);
+    if (startMinimized) {
+        // Applies to the child's first ShowWindow call
+        startup.dwFlags = STARTF_USESHOWWINDOW;
+        startup.wShowWindow = SW_SHOWMINNOACTIVE;
+    }
+    PROCESS_INFORMATION info{};
+    if (!CreateProcessW(application.c_str(), commandLine.data(), nullptr, nullptr, FALSE, 0,
+                        nullptr, nullptr, &startup, &info)) {
+        std::cerr << "spawnProcess: CreateProcessW failed for " << argv[0] << " (error " << GetLastError() << ")\n";
+        return std::nullopt;
+    }
+    CloseHandle(info.hThread);
+
+    SpawnedProcess process;
+    process.pid = info.dwProcessId;
+    process.handle = info.hProcess;
+    return process;
+}
+
+bool revealProcessWindow(ProcessId pid) {
+    WindowSearch search{pid, false};
+    EnumWindows(&restoreWindow, reinterpret_cast<LPARAM>(&search));
+    return search.found;
+}
+
+#else
+
+std::optional<SpawnedProcess> spawnProcess(const std::vector<std::string>& argv, bool /*startMinimized*/) {
+    if (argv.empty()) return std::nullopt;
+
+    std::vector<char*> args;
+    for (const auto& arg : argv) {
+        args.push_back(const_cast<char*>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+
+    pid_t pid = 0;
+    const int err = posix_spawn(&pid, argv[0].c_str(), nullptr, nullptr, args.data(), environ);
+    if (err != 0) {
+        std::cerr << "spawnProcess: posix_spawn failed for " << argv[0] << ": " << std::strerror(err) << "\n";
+        return std::nullopt;
+    }
+
+    SpawnedProcess process;
+    process.pid = pid;
+    return process;
+}
+
+bool revealProcessWindow(ProcessId /*pid*/) {
+    return false;
+}
+
+#endif
+
+void LaunchLatencyProbe::start(std::optional<ProcessId> pid, const std::string& processName,
+                               TimePoint enterPressed, TimePoint spawnStarted, TimePoint spawnFinished) {
+    stop();
+    cancel_ = false;
+    thread_ = std::thread(&LaunchLatencyProbe::run, this, pid, processName, enterPressed, spawnStarted, spawnFinished);
+}
+
+void LaunchLatencyProbe::stop() {
+    cancel_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void LaunchLatencyProbe::run(std::optional<ProcessId> pid, std::string processName,
+                             TimePoint enterPressed, TimePoint spawnStarted, TimePoint spawnFinished) {
+    // A shell launch has no PID to hand over; tagging each line lets the two modes be compared from the log
+    const char* mode = pid ? "direct" : "shell";
+    std::cout << "[Perf] Launch (" << mode << ") Enter -> spawn: " << millisecondsBetween(enterPressed, spawnStarted) << " ms"
+              << " | spawn call: " << millisecondsBetween(spawnStarted, spawnFinished) << " ms\n";
+
+#ifdef _WIN32
+    // Short-lived polling, only while a game is starting
+    const auto deadline = spawnFinished + std::chrono::seconds(60);
+    while (!cancel_ && std::chrono::steady_clock::now() < deadline) {
+        if (!pid) {
+            pid = ProcessSupervisor::findProcessByName(processName);
+        }
+        if (pid && hasVisibleWindow(*pid)) {
+            const auto now = std::chrono::steady_clock::now();
+            std::cout << "[Perf] Launch (" << mode << ") spawn -> first window: " << millisecondsBetween(spawnFinished, now) << " ms"
+                      << " | Enter -> first window: " << millisecondsBetween(enterPressed, now) << " ms\n";
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(pid ? 10 : 50));
+    }
+    if (!cancel_) {
+        std::cout << "[Perf] Launch (" << mode << ") no window from " << processName << " within 60 s\n";
+    }
+#else
+    // No portable "window mapped" signal without talking to the display server
+    (void)pid;
+    (void)processName;
+#endif
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+using ProcessId = unsigned long; // DWORD
+using NativeHandle = void*;      // HANDLE
+#else
+using ProcessId = int;           // pid_t
+#endif
+
+/**
+ * A process started by spawnProcess(). On Windows `handle` is an owned
+ * process handle for ProcessSupervisor to take over.
+ */
+struct SpawnedProcess {
+    ProcessId pid = 0;
+#ifdef _WIN32
+    NativeHandle handle = nullptr;
+#endif
+};
+
+// Starts argv[0] with the given arguments directly (CreateProcessW / posix_spawn), without a shell,
+// so paths with spaces, quotes or shell metacharacters are passed through untouched.
+// startMinimized asks for the first window to open minimized and inactive (Windows only).
+std::optional<SpawnedProcess> spawnProcess(const std::vector<std::string>& argv, bool startMinimized = false);
+
+// Restores and focuses the top-level windows of pid. False if it has none yet (or off Windows).
+bool revealProcessWindow(ProcessId pid);
+
+/**
+ * Measures how long a launched game takes to show its first visible window.
+ * Runs on its own thread so the main loop can keep sleeping; prints the
+ * Enter -> spawn, spawn duration and spawn -> first window times once known.
+ * Each line names the launch mode, so running once with "launch_via_shell"
+ * and once without compares the direct spawn against the old shell path.
+ */
+class LaunchLatencyProbe {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    ~LaunchLatencyProbe() { stop(); }
+
+    // pid may be unknown (shell launch); the probe then finds the process by processName
+    void start(std::optional<ProcessId> pid, const std::string& processName,
+               TimePoint enterPressed, TimePoint spawnStarted, TimePoint spawnFinished);
+    void stop();
+
+private:
+    void run(std::optional<ProcessId> pid, std::string processName,
+             TimePoint enterPressed, TimePoint spawnStarted, TimePoint spawnFinished);
+
+    std::atomic<bool> cancel_{false};
+    std::thread thread_;
+};
@@ -0,0 +1,252 @@
+#include "ProcessSupervisor.hpp"
+#include "WakeQueue.hpp"
+#include <iostream>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <tlhelp32.h>
+#else
+    #include <cerrno>
+    #include <csignal>
+    #include <filesystem>
+    #include <fstream>
+    #include <poll.h>
+    #include <sys/syscall.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+
+    // Older libc headers don't name these yet; the syscall numbers are the same on every architecture
+    #ifndef SYS_pidfd_open
+        #define SYS_pidfd_open 434
+    #endif
+    #ifndef SYS_pidfd_send_signal
+        #define SYS_pidfd_send_signal 424
+    #endif
+    #ifndef P_PIDFD
+        #define P_PIDFD 3
+    #endif
+#endif
+
+ProcessSupervisor::ProcessSupervisor(WakeQueue& wakeQueue)
+    : wakeQueue_(wakeQueue) {
+}
+
+ProcessSupervisor::~ProcessSupervisor() {
+    release();
+}
+
+std::optional<int> ProcessSupervisor::exitCode() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return exitCode_;
+}
+
+void ProcessSupervisor::onExit(int exitCode) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exitCode_ = exitCode;
+    }
+    running_ = false;
+    std::cout << "ProcessSupervisor: process " << pid_ << " exited with code " << exitCode << "\n";
+    wakeQueue_.post(WakeReason::ProcessExited);
+}
+
+#ifdef _WIN32
+
+struct ProcessSupervisor::WaitThunk {
+    static VOID CALLBACK invoke(PVOID context, BOOLEAN /*timedOut*/) {
+        auto* self = static_cast<ProcessSupervisor*>(context);
+        DWORD code = 0;
+        self->onExit(GetExitCodeProcess(self->process_, &code) ? static_cast<int>(code) : -1);
+    }
+};
+
+bool ProcessSupervisor::adopt(ProcessId pid) {
+    HANDLE process = OpenProcess(SYNCHRONIZE | PROCESS_TERMINATE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!process) {
+        std::cerr << "ProcessSupervisor: cannot open process " << pid << "\n";
+        return false;
+    }
+    return adoptHandle(process);
+}
+
+bool ProcessSupervisor::adopt(SpawnedProcess& process) {
+    NativeHandle handle = process.handle;
+    process.handle = nullptr;
+    return handle ? adoptHandle(handle) : adopt(process.pid);
+}
+
+bool ProcessSupervisor::adoptHandle(NativeHandle process) {
+    release();
+
+    process_ = process;
+    pid_ = GetProcessId(process);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exitCode_.reset();
+    }
+    running_ = true;
+    supervising_ = true;
+
+    // The thread pool waits on the handle; nothing runs until the process exits
+    if (!RegisterWaitForSingleObject(&wait_, process_, &WaitThunk::invoke, this, INFINITE, WT_EXECUTEONLYONCE)) {
+        std::cerr << "ProcessSupervisor: RegisterWaitForSingleObject failed for process " << pid_ << "\n";
+        wait_ = nullptr;
+        release();
+        return false;
+    }
+    return true;
+}
+
+void ProcessSupervisor::release() {
+    if (wait_) {
+        // Blocks until a callback that is already running has returned
+        UnregisterWaitEx(wait_, INVALID_HANDLE_VALUE);
+        wait_ = nullptr;
+    }
+    if (process_) {
+        CloseHandle(process_);
+        process_ = nullptr;
+    }
+    supervising_ = false;
+    running_ = false;
+}
+
+bool ProcessSupervisor::terminate() {
+    if (!process_ || !running_) return false;
+    return TerminateProcess(process_, 1) != 0;
+}
+
+std::optional<ProcessSupervisor::ProcessId> ProcessSupervisor::findProcessByName(const std::string& fragment) {
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) return std::nullopt;
+
+    std::optional<ProcessId> found;
+    PROCESSENTRY32 entry;
+    entry.dwSize = sizeof(PROCESSENTRY32);
+    if (Process32First(snapshot, &entry)) {
+        do {
+            if (std::string(entry.szExeFile).find(fragment) != std::string::npos) {
+                found = entry.th32ProcessID;
+                break;
+            }
+        } while (Process32Next(snapshot, &entry));
+    }
+    CloseHandle(snapshot);
+    return found;
+}
+
+#else
+
+bool ProcessSupervisor::adopt(ProcessId pid) {
+    release();
+
+    pid_ = pid;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exitCode_.reset();
+    }
+
+    pidfd_ = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+    if (pidfd_ < 0 && errno != ENOSYS) {
+        std::cerr << "ProcessSupervisor: cannot open process " << pid << "\n";
+        return false;
+    }
+    if (pipe(cancelPipe_) != 0) {
+        std::cerr << "ProcessSupervisor: pipe() failed\n";
+        release();
+        return false;
+    }
+
+    running_ = true;
+    supervising_ = true;
+    watcher_ = std::thread(&ProcessSupervisor::watchLoop, this);
+    return true;
+}
+
+bool ProcessSupervisor::adopt(SpawnedProcess& process) {
+    return adopt(process.pid);
+}
+
+void ProcessSupervisor::watchLoop() {
+    auto decodeStatus = [](int status) {
+        return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    };
+
+    if (pidfd_ >= 0) {
+        // The pidfd becomes readable when the process exits; the pipe only when we are released
+        pollfd fds[2] = {{pidfd_, POLLIN, 0}, {cancelPipe_[0], POLLIN, 0}};
+        while (poll(fds, 2, -1) < 0 && errno == EINTR) {
+        }
+        if (fds[1].revents) return;
+
+        // Reaps our own child; for an adopted non-child this fails with ECHILD and the code is unknown
+        siginfo_t info{};
+        int code = -1;
+        if (waitid(static_cast<idtype_t>(P_PIDFD), static_cast<id_t>(pidfd_), &info, WEXITED) == 0) {
+            code = info.si_code == CLD_EXITED ? info.si_status : 128 + info.si_status;
+        }
+        onExit(code);
+        return;
+    }
+
+    // Kernels without pidfd (< 5.3): slow poll, still woken immediately by release()
+    pollfd cancel = {cancelPipe_[0], POLLIN, 0};
+    while (poll(&cancel, 1, 250) <= 0) {
+        int status = 0;
+        const pid_t result = waitpid(pid_, &status, WNOHANG);
+        if (result == pid_) {
+            onExit(decodeStatus(status));
+            return;
+        }
+        if (result < 0 && errno == ECHILD && kill(pid_, 0) != 0 && errno == ESRCH) {
+            onExit(-1);
+            return;
+        }
+    }
+}
+
+void ProcessSupervisor::release() {
+    if (watcher_.joinable()) {
+        const char wake = 1;
+        if (write(cancelPipe_[1], &wake, 1) < 0) {
+            std::cerr << "ProcessSupervisor: failed to signal watcher\n";
+        }
+        watcher_.join();
+    }
+    for (int& fd : cancelPipe_) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+    if (pidfd_ >= 0) {
+        close(pidfd_);
+        pidfd_ = -1;
+    }
+    supervising_ = false;
+    running_ = false;
+}
+
+bool ProcessSupervisor::terminate() {
+    if (!running_) return false;
+    // Signalling through the pidfd can't hit a recycled PID
+    if (pidfd_ >= 0) {
+        return syscall(SYS_pidfd_send_signal, pidfd_, SIGTERM, nullptr, 0) == 0;
+    }
+    return kill(pid_, SIGTERM) == 0;
+}
+
+std::optional<ProcessSupervisor::ProcessId> ProcessSupervisor::findProcessByName(const std::string& fragment) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc", ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.empty() || name.find_first_not_of("0123456789") != std::string::npos) continue;
+
+        std::ifstream comm(entry.path() / "comm");
+        std::string command;
+        if (std::getline(comm, command) && command.find(fragment) != std::string::npos) {
+            return static_cast<ProcessId>(std::stoi(name));
+        }
+    }
+    return std::nullopt;
+}
+
+#endif
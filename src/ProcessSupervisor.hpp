@@ -0,0 +1,76 @@
+#pragma once
+#include "ProcessSpawn.hpp"
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+class WakeQueue;
+
+/**
+ * Watches the one emulator process the launcher started and reports its exit
+ * without any per-frame work. The exit is noticed by the OS, not by polling:
+ * a registered handle wait on Windows, a pidfd (falling back to a slow
+ * kill(pid, 0) poll on old kernels) on Linux. When it fires, isRunning()
+ * flips to false and WakeReason::ProcessExited is posted to the wake queue.
+ * terminate() only ever touches that process.
+ */
+class ProcessSupervisor {
+public:
+    using ProcessId = ::ProcessId;
+#ifdef _WIN32
+    using NativeHandle = ::NativeHandle;
+#endif
+
+    explicit ProcessSupervisor(WakeQueue& wakeQueue);
+    ~ProcessSupervisor();
+
+    ProcessSupervisor(const ProcessSupervisor&) = delete;
+    ProcessSupervisor& operator=(const ProcessSupervisor&) = delete;
+
+    // Starts supervising pid, replacing any previous process. Returns false if it can't be opened.
+    bool adopt(ProcessId pid);
+    // Same for a process we spawned; takes ownership of its handle
+    bool adopt(SpawnedProcess& process);
+#ifdef _WIN32
+    // Takes ownership of an already-open process handle (needs SYNCHRONIZE access)
+    bool adoptHandle(NativeHandle process);
+#endif
+
+    // Stops watching without touching the process
+    void release();
+
+    bool isSupervising() const { return supervising_.load(); }
+    bool isRunning() const { return running_.load(); }
+    std::optional<ProcessId> processId() const { return supervising_ ? std::optional<ProcessId>(pid_) : std::nullopt; }
+    std::optional<int> exitCode() const;
+
+    // Asks the supervised process to exit. Never affects any other process.
+    bool terminate();
+
+    // One-off lookup of a process whose executable name contains `fragment`.
+    // Only used to pick up a process started through a shell, never per frame.
+    static std::optional<ProcessId> findProcessByName(const std::string& fragment);
+
+private:
+    void onExit(int exitCode);
+
+    WakeQueue& wakeQueue_;
+    std::atomic<bool> supervising_{false};
+    std::atomic<bool> running_{false};
+    mutable std::mutex mutex_;
+    std::optional<int> exitCode_;
+    ProcessId pid_ = 0;
+
+#ifdef _WIN32
+    struct WaitThunk; // Thread-pool callback for the registered wait
+    NativeHandle process_ = nullptr;
+    NativeHandle wait_ = nullptr;
+#else
+    void watchLoop();
+    int pidfd_ = -1;
+    int cancelPipe_[2] = {-1, -1};
+    std::thread watcher_;
+#endif
+};
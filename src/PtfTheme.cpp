@@ -0,0 +1,268 @@
+#include "PtfTheme.hpp"
+#include "GimDecoder.hpp"
+#include "Inflate.hpp"
+#include "PerfStats.hpp"
+#include <SFML/Graphics.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+constexpr char PTF_MAGIC[4] = {'\0', 'P', 'T', 'F'};
+constexpr std::size_t HEADER_BYTES = 0x100;
+constexpr std::size_t TITLE_OFFSET = 0x08;
+constexpr std::size_t TITLE_BYTES = 0x80;
+constexpr std::size_t MAX_SECTIONS = 8; // The offset table fills 0x100-0x11F
+constexpr std::size_t SECTION_HEADER_BYTES = 0x20;
+constexpr std::size_t ENTRY_HEADER_BYTES = 0x20;
+
+// Bumped when extraction changes, so older caches are rebuilt once
+constexpr int CACHE_VERSION = 1;
+
+std::uint16_t readU16(const std::uint8_t* p) {
+    return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+std::uint32_t readU32(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+bool writeFile(const std::string& path, const std::uint8_t* data, std::size_t size) {
+    // Written aside and renamed, so an interrupted write never looks like a finished extraction
+    const std::string tempPath = path + ".tmp";
+    std::error_code ec;
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!out) ec = std::make_error_code(std::errc::io_error);
+    }
+    if (!ec) fs::rename(tempPath, path, ec);
+    if (ec) fs::remove(tempPath, ec);
+    return !ec;
+}
+
+} // namespace
+
+PtfTheme::PtfTheme(std::string cacheRoot)
+    : cacheRoot_(std::move(cacheRoot)) {
+}
+
+bool PtfTheme::open(const std::string& path) {
+    path_ = path;
+    title_.clear();
+    sections_.clear();
+    extracted_.clear();
+    cacheChecked_ = false;
+
+    std::ifstream in(path, std::ios::binary);
+    std::uint8_t header[HEADER_BYTES + MAX_SECTIONS * 4];
+    if (!in.read(reinterpret_cast<char*>(header), sizeof(header)) || std::memcmp(header, PTF_MAGIC, sizeof(PTF_MAGIC)) != 0) {
+        std::cerr << "PtfTheme: " << path << " is not a PTF theme\n";
+        return false;
+    }
+
+    const char* title = reinterpret_cast<const char*>(header + TITLE_OFFSET);
+    title_.assign(title, strnlen(title, TITLE_BYTES));
+
+    std::error_code ec;
+    fileSize_ = fs::file_size(path, ec);
+    fileMtime_ = static_cast<std::int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+    cacheDir_ = cacheRoot_ + "/" + fs::path(path).stem().string();
+
+    // Offsets of the section headers; the table ends at the first zero or where the first section starts
+    std::uint32_t tableEnd = static_cast<std::uint32_t>(sizeof(header));
+    for (std::size_t i = 0; i < MAX_SECTIONS && HEADER_BYTES + i * 4 < tableEnd; ++i) {
+        const std::uint32_t offset = readU32(header + HEADER_BYTES + i * 4);
+        if (offset == 0 || offset + SECTION_HEADER_BYTES > fileSize_) break;
+        tableEnd = std::min(tableEnd, offset);
+
+        std::uint8_t sectionHeader[12];
+        in.seekg(offset);
+        if (!in.read(reinterpret_cast<char*>(sectionHeader), sizeof(sectionHeader))) break;
+        Section section;
+        section.type = readU16(sectionHeader);
+        section.entryCount = readU16(sectionHeader + 2);
+        section.firstEntry = readU32(sectionHeader + 8);
+        sections_.push_back(std::move(section));
+    }
+
+    if (sections_.empty()) {
+        std::cerr << "PtfTheme: " << path << " has no sections\n";
+        return false;
+    }
+    return true;
+}
+
+bool PtfTheme::hasSection(std::uint16_t type) const {
+    return std::any_of(sections_.begin(), sections_.end(), [type](const Section& s) { return s.type == type; });
+}
+
+PtfTheme::Section* PtfTheme::findSection(std::uint16_t type) {
+    auto it = std::find_if(sections_.begin(), sections_.end(), [type](const Section& s) { return s.type == type; });
+    return it != sections_.end() ? &*it : nullptr;
+}
+
+const std::vector<PtfTheme::Entry>& PtfTheme::entries(std::uint16_t type) {
+    static const std::vector<Entry> none;
+    Section* section = findSection(type);
+    if (!section) return none;
+    if (section->indexed) return section->entries;
+    section->indexed = true;
+
+    // Entries follow each other: a 0x20-byte header, then its payload
+    std::ifstream in(path_, std::ios::binary);
+    std::uint64_t offset = section->firstEntry;
+    for (std::uint16_t i = 0; i < section->entryCount; ++i) {
+        std::uint8_t header[16];
+        in.seekg(static_cast<std::streamoff>(offset));
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) break;
+        Entry entry;
+        entry.id = readU32(header);
+        entry.storedSize = readU32(header + 8);
+        entry.rawSize = readU32(header + 12);
+        entry.dataOffset = offset + ENTRY_HEADER_BYTES;
+        if (entry.dataOffset + entry.storedSize > fileSize_) break;
+        section->entries.push_back(entry);
+        offset = entry.dataOffset + entry.storedSize;
+    }
+    return section->entries;
+}
+
+const PtfTheme::Entry* PtfTheme::findEntry(std::uint16_t section, std::uint32_t id) {
+    const std::vector<Entry>& list = entries(section);
+    auto it = std::find_if(list.begin(), list.end(), [id](const Entry& e) { return e.id == id; });
+    return it != list.end() ? &*it : nullptr;
+}
+
+bool PtfTheme::readPayload(const Entry& entry, std::vector<std::uint8_t>& out) const {
+    std::ifstream in(path_, std::ios::binary);
+    std::vector<std::uint8_t> stored(entry.storedSize);
+    in.seekg(static_cast<std::streamoff>(entry.dataOffset));
+    if (!in.read(reinterpret_cast<char*>(stored.data()), static_cast<std::streamsize>(stored.size()))) return false;
+
+    // Tiny entries (the colour) are stored as they are; everything else is a zlib stream
+    if (entry.storedSize >= entry.rawSize) {
+        stored.resize(entry.rawSize);
+        out = std::move(stored);
+        return true;
+    }
+    return inflate::zlib(stored.data(), stored.size(), out, entry.rawSize) && out.size() == entry.rawSize;
+}
+
+void PtfTheme::prepareCacheDir() {
+    if (cacheChecked_) return;
+    cacheChecked_ = true;
+
+    // The sidecar stamps which .ptf the folder was extracted from; anything else is stale
+    const std::string infoPath = cacheDir_ + "/INFO.JSON";
+    std::ifstream info(infoPath);
+    if (info) {
+        try {
+            json j;
+            info >> j;
+            if (j.value("version", 0) == CACHE_VERSION && j.value("size", std::uint64_t{0}) == fileSize_ &&
+                j.value("mtime", std::int64_t{0}) == fileMtime_) {
+                return;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: ignoring " << infoPath << ": " << e.what() << "\n";
+        }
+        info.close();
+    }
+
+    std::error_code ec;
+    fs::remove_all(cacheDir_, ec);
+    fs::create_directories(cacheDir_, ec);
+    std::ofstream out(infoPath);
+    if (!out) {
+        std::cerr << "PtfTheme: cannot write " << infoPath << "\n";
+        return;
+    }
+    json j;
+    j["version"] = CACHE_VERSION;
+    j["title"] = title_;
+    j["size"] = fileSize_;
+    j["mtime"] = fileMtime_;
+    out << j.dump(2);
+}
+
+std::string PtfTheme::extract(std::uint16_t section, std::uint32_t id, const std::string& baseName) {
+    for (const Extracted& done : extracted_) {
+        if (done.section == section && done.id == id) return done.path;
+    }
+    auto remember = [&](std::string path) {
+        extracted_.push_back({section, id, path});
+        return path;
+    };
+
+    // GIMs are converted to PNG; BMP and PNG payloads are kept as they are
+    prepareCacheDir();
+    for (const char* extension : {".PNG", ".BMP"}) {
+        const std::string cached = cacheDir_ + "/" + baseName + extension;
+        if (fs::exists(cached)) return remember(cached);
+    }
+
+    sf::Clock timer;
+    const Entry* entry = findEntry(section, id);
+    std::vector<std::uint8_t> payload;
+    if (!entry || !readPayload(*entry, payload)) {
+        if (entry) std::cerr << "PtfTheme: cannot read " << baseName << " from " << path_ << "\n";
+        return remember(std::string());
+    }
+
+    std::string outPath;
+    if (GimDecoder::isGim(payload)) {
+        std::optional<sf::Image> image = GimDecoder::decode(payload);
+        std::optional<std::vector<std::uint8_t>> png = image ? image->saveToMemory("png") : std::nullopt;
+        if (png) {
+            outPath = cacheDir_ + "/" + baseName + ".PNG";
+            if (!writeFile(outPath, png->data(), png->size())) outPath.clear();
+        }
+    } else if (payload.size() > 2 && payload[0] == 'B' && payload[1] == 'M') {
+        outPath = cacheDir_ + "/" + baseName + ".BMP";
+        if (!writeFile(outPath, payload.data(), payload.size())) outPath.clear();
+    } else if (payload.size() > 8 && std::memcmp(payload.data(), "\x89PNG", 4) == 0) {
+        outPath = cacheDir_ + "/" + baseName + ".PNG";
+        if (!writeFile(outPath, payload.data(), payload.size())) outPath.clear();
+    }
+
+    if (outPath.empty()) {
+        std::cerr << "PtfTheme: cannot extract " << baseName << " from " << path_ << "\n";
+    } else {
+        std::cout << "PtfTheme: extracted " << outPath << "\n";
+        if (perf::enabled()) {
+            std::cout << "[Perf] Extracted " << baseName << " from " << path_ << " in "
+                      << timer.getElapsedTime().asMicroseconds() / 1000.0 << " ms\n";
+        }
+    }
+    return remember(outPath);
+}
+
+std::string PtfTheme::wallpaperPath() {
+    const std::vector<Entry>& list = entries(SECTION_WALLPAPER);
+    return list.empty() ? std::string() : extract(SECTION_WALLPAPER, list.front().id, "WALLPAPER");
+}
+
+std::string PtfTheme::previewPath() {
+    return extract(SECTION_PREVIEW, 1, "PREVIEW");
+}
+
+std::string PtfTheme::iconPath(std::uint16_t section, std::uint32_t id) {
+    return extract(section, id, "ICON" + std::to_string(section) + "_" + std::to_string(id));
+}
+
+std::optional<std::uint32_t> PtfTheme::colorPreset() {
+    const Entry* entry = findEntry(SECTION_PREVIEW, 2);
+    std::vector<std::uint8_t> payload;
+    if (!entry || !readPayload(*entry, payload) || payload.size() < 4) return std::nullopt;
+    return readU32(payload.data());
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * A PSP custom theme (.ptf). open() reads only the 0x100-byte header and
+ * the section table; a section's entry table is read the first time one
+ * of its entries is wanted, and an entry's payload (zlib-compressed GIM
+ * or BMP, see Inflate and GimDecoder) only when it is extracted.
+ *
+ * Extracted images are kept as ordinary files in a per-theme folder under
+ * the cache root, stamped with the .ptf's size and mtime, so each one is
+ * decoded at most once; callers load them by path like any other art.
+ */
+class PtfTheme {
+public:
+    // Section types as found in firmware 3.x-6.x themes
+    static constexpr std::uint16_t SECTION_PREVIEW = 0;        // Preview picture (id 1), its icon (id 0), colour (id 2)
+    static constexpr std::uint16_t SECTION_WALLPAPER = 1;      // 480x272 BMP
+    static constexpr std::uint16_t SECTION_CATEGORY_ICONS = 2; // One GIM per XMB category
+    static constexpr std::uint16_t SECTION_ITEM_ICONS = 3;     // Item icons, normal/selected pairs
+    static constexpr std::uint16_t SECTION_SMALL_ICONS = 4;
+
+    struct Entry {
+        std::uint32_t id = 0;
+        std::uint32_t storedSize = 0; // Bytes in the file (zlib stream, padded to 4)
+        std::uint32_t rawSize = 0;    // Bytes once inflated; equal to storedSize when stored as-is
+        std::uint64_t dataOffset = 0;
+    };
+
+    explicit PtfTheme(std::string cacheRoot = "assets/Themes/.cache");
+
+    // Reads the header and section table; false if the file isn't a PTF
+    bool open(const std::string& path);
+
+    const std::string& path() const { return path_; }
+    const std::string& title() const { return title_; }
+    bool hasSection(std::uint16_t type) const;
+
+    // Entries of one section, indexed on first use
+    const std::vector<Entry>& entries(std::uint16_t type);
+
+    // Path of the extracted image, extracting it now if needed; empty if the theme has none
+    std::string wallpaperPath();
+    std::string previewPath();
+    std::string iconPath(std::uint16_t section, std::uint32_t id);
+
+    // Theme colour preset stored with the preview, if present
+    std::optional<std::uint32_t> colorPreset();
+
+private:
+    struct Section {
+        std::uint16_t type = 0;
+        std::uint16_t entryCount = 0;
+        std::uint32_t firstEntry = 0;
+        bool indexed = false;
+        std::vector<Entry> entries;
+    };
+
+    struct Extracted {
+        std::uint16_t section;
+        std::uint32_t id;
+        std::string path;
+    };
+
+    Section* findSection(std::uint16_t type);
+    const Entry* findEntry(std::uint16_t section, std::uint32_t id);
+    bool readPayload(const Entry& entry, std::vector<std::uint8_t>& out) const;
+    std::string extract(std::uint16_t section, std::uint32_t id, const std::string& baseName);
+    void prepareCacheDir();
+
+    std::string cacheRoot_;
+    std::string path_;
+    std::string cacheDir_;
+    bool cacheChecked_ = false;
+    std::string title_;
+    std::uint64_t fileSize_ = 0;
+    std::int64_t fileMtime_ = 0;
+    std::vector<Section> sections_;
+    std::vector<Extracted> extracted_; // Paths already resolved, so repeated calls don't touch the disk
+};
@@ -57,19 +57,33 @@ void QuickMenu::reset() {
     choice_ = Choice::None;
     selectedOption_ = 0;
     visible_ = false;
+    navInput_.reset();
 }
 
 void QuickMenu::handleEvent(const sf::Event& event) {
     if (!visible_) return;
     
+    // Arrow keys, D-pad axes and stick: one step per push
+    if (const auto action = navInput_.handleEvent(event)) {
+        if (*action == NavAction::Up) {
+            sounds_.playCursor();
+            selectedOption_ = (selectedOption_ == 0) ? 1 : 0;
+            selectionIndicator_.setPosition({410.f, selectedOption_ == 0 ? 335.f : 395.f});
+        } else if (*action == NavAction::Down) {
+            sounds_.playCursor();
+            selectedOption_ = (selectedOption_ == 1) ? 0 : 1;
+            selectionIndicator_.setPosition({410.f, selectedOption_ == 0 ? 335.f : 395.f});
+        }
+    }
+    
     // Handle keyboard input
     if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-        if (keyPressed->code == sf::Keyboard::Key::Up || keyPressed->code == sf::Keyboard::Key::W) {
+        if (keyPressed->code == sf::Keyboard::Key::W) {
             sounds_.playCursor();
             selectedOption_ = (selectedOption_ == 0) ? 1 : 0;
             selectionIndicator_.setPosition({410.f, selectedOption_ == 0 ? 335.f : 395.f});
         }
-        else if (keyPressed->code == sf::Keyboard::Key::Down || keyPressed->code == sf::Keyboard::Key::S) {
+        else if (keyPressed->code == sf::Keyboard::Key::S) {
             sounds_.playCursor();
             selectedOption_ = (selectedOption_ == 1) ? 0 : 1;
             selectionIndicator_.setPosition({410.f, selectedOption_ == 0 ? 335.f : 395.f});
@@ -115,33 +129,10 @@ void QuickMenu::handleEvent(const sf::Event& event) {
             visible_ = false;
         }
     }
-    
-    // Handle joystick axis for analog stick navigation
-    if (const auto* axisMoved = event.getIf<sf::Event::JoystickMoved>()) {
-        if (axisMoved->axis == sf::Joystick::Axis::Y) {
-            static float lastYAxis = 0.f;
-            float currentYAxis = axisMoved->position;
-            
-            // Up movement (positive Y axis - inverted)
-            if (currentYAxis > 50.f && lastYAxis <= 50.f) {
-                sounds_.playCursor();
-                selectedOption_ = (selectedOption_ == 0) ? 1 : 0;
-                selectionIndicator_.setPosition({410.f, selectedOption_ == 0 ? 335.f : 395.f});
-            }
-            // Down movement (negative Y axis - inverted)
-            else if (currentYAxis < -50.f && lastYAxis >= -50.f) {
-                sounds_.playCursor();
-                selectedOption_ = (selectedOption_ == 1) ? 0 : 1;
-                selectionIndicator_.setPosition({410.f, selectedOption_ == 0 ? 335.f : 395.f});
-            }
-            
-            lastYAxis = currentYAxis;
-        }
-    }
 }
 
 void QuickMenu::update(float dt) {
-    // Could add animations here if needed
+    navInput_.update(dt); // Only clears presses whose release went elsewhere
 }
 
 void QuickMenu::draw(sf::RenderWindow& window) {
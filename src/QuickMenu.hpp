@@ -2,6 +2,7 @@
 #include <SFML/Graphics.hpp>
 #include <optional>
 #include "UiSoundBank.hpp"
+#include "InputRepeater.hpp"
 
 class QuickMenu {
 public:
@@ -15,6 +16,7 @@ public:
     void show();
     void hide();
     bool isVisible() const { return visible_; }
+    bool isAnimating() const { return false; } // Only input changes what is drawn
     void handleEvent(const sf::Event& event);
     void update(float dt);
     void draw(sf::RenderWindow& window);
@@ -26,6 +28,7 @@ private:
     bool visible_;
     Choice choice_;
     int selectedOption_; // 0 = Resume, 1 = Return to Menu
+    InputRepeater navInput_{InputRepeater::Config::stepsOnly()};
     
     sf::RectangleShape overlay_;
     sf::RectangleShape dialogBox_;
@@ -1,11 +1,14 @@
 #include "RomAssetManager.hpp"
 #include "GameMetadataExtractor.hpp"
+#include "PmfDemuxer.hpp"
+#include <nlohmann/json.hpp>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <algorithm>
 
 namespace fs = std::filesystem;
+using json = nlohmann::json;
 
 static std::string sanitizeFilename(std::string name) {
     std::replace(name.begin(), name.end(), ':', '_');
@@ -20,6 +23,36 @@ static std::string sanitizeFilename(std::string name) {
     return name;
 }
 
+// Bumped when the cache starts keeping more files, so older caches extract the new ones once
+static constexpr int INFO_VERSION = 2; // 2: ICON1.PMF, PIC0.PNG
+
+// Title and disc ID live next to the cached art so a cache hit doesn't lose them.
+// False if the sidecar is missing or older than INFO_VERSION.
+static bool readInfoSidecar(const std::string& path, CachedAssets& assets) {
+    std::ifstream file(path);
+    if (!file) return false;
+    try {
+        json j;
+        file >> j;
+        assets.title = j.value("title", std::string());
+        assets.discId = j.value("disc_id", std::string());
+        return j.value("version", 1) >= INFO_VERSION;
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: ignoring " << path << ": " << e.what() << "\n";
+        return false;
+    }
+}
+
+static void writeInfoSidecar(const std::string& path, const GameMetadata& meta) {
+    std::ofstream file(path);
+    if (!file) return;
+    json j;
+    j["title"] = meta.title;
+    j["disc_id"] = meta.gameId;
+    j["version"] = INFO_VERSION;
+    file << j.dump(2);
+}
+
 static void writeDataToFile(const std::string& path, const std::vector<uint8_t>& data) {
     if (data.empty()) return;
     if (fs::exists(path)) return; // Don't overwrite
@@ -31,6 +64,13 @@ static void writeDataToFile(const std::string& path, const std::vector<uint8_t>&
     }
 }
 
+// ffmpeg can't read a PMF directly, so its video is demuxed once into a raw stream next to it
+static std::string iconVideoFor(const std::string& pmfPath, const std::string& videoPath) {
+    if (fs::exists(videoPath)) return videoPath;
+    if (fs::exists(pmfPath) && PmfDemuxer::extractVideo(pmfPath, videoPath)) return videoPath;
+    return std::string();
+}
+
 CachedAssets RomAssetManager::getOrExtractAssets(const std::string& romPath, const std::string& cacheRoot) {
     CachedAssets assets;
     
@@ -42,8 +82,12 @@ CachedAssets RomAssetManager::getOrExtractAssets(const std::string& romPath, con
     // 2. Check if assets already exist
     std::string iconPath = gameCacheDir + "/ICON0.PNG";
     std::string bgPath = gameCacheDir + "/PIC1.PNG";
+    std::string overlayPath = gameCacheDir + "/PIC0.PNG";
+    std::string pmfPath = gameCacheDir + "/ICON1.PMF";
+    std::string iconVideoPath = gameCacheDir + "/ICON1.H264";
     std::string sndPath = gameCacheDir + "/SND0.AT3";
     std::string wavPath = gameCacheDir + "/PREVIEW.WAV";
+    std::string infoPath = gameCacheDir + "/INFO.JSON";
     
     bool iconExists = fs::exists(iconPath);
     bool bgExists = fs::exists(bgPath);
@@ -67,8 +111,22 @@ CachedAssets RomAssetManager::getOrExtractAssets(const std::string& romPath, con
             }
         }
         
-        // Try to read title from a sidecar file if we had one, otherwise leave empty
-        // (Menu will use filename)
+        // Read title and disc ID from the sidecar; caches made before it existed (or before
+        // ICON1/PIC0 were kept) are topped up now, the rest of the art is already on disk
+        if (!readInfoSidecar(infoPath, assets)) {
+            try {
+                GameMetadata meta = GameMetadataExtractor::extract(romPath);
+                assets.title = meta.title;
+                assets.discId = meta.gameId;
+                writeDataToFile(pmfPath, meta.iconVideoData);
+                writeDataToFile(overlayPath, meta.overlayData);
+                writeInfoSidecar(infoPath, meta);
+            } catch (const std::exception& e) {
+                std::cerr << "Error extracting metadata from " << romPath << ": " << e.what() << "\n";
+            }
+        }
+        if (fs::exists(overlayPath)) assets.coverPath = overlayPath;
+        assets.iconVideoPath = iconVideoFor(pmfPath, iconVideoPath);
         return assets;
     }
 
@@ -84,6 +142,7 @@ CachedAssets RomAssetManager::getOrExtractAssets(const std::string& romPath, con
     }
 
     assets.title = meta.title;
+    assets.discId = meta.gameId;
 
     // If we got a real ID from the ISO, we could use it, but to keep consistent with the cache check above,
     // we should stick to the filename-based ID. 
@@ -97,6 +156,8 @@ CachedAssets RomAssetManager::getOrExtractAssets(const std::string& romPath, con
     }
 
     // 4. Save assets and populate paths
+    writeInfoSidecar(infoPath, meta);
+
     if (!meta.iconData.empty()) {
         writeDataToFile(iconPath, meta.iconData);
         assets.iconPath = iconPath;
@@ -105,7 +166,17 @@ CachedAssets RomAssetManager::getOrExtractAssets(const std::string& romPath, con
     if (!meta.backgroundData.empty()) {
         writeDataToFile(bgPath, meta.backgroundData);
         assets.backgroundPath = bgPath;
-        assets.coverPath = bgPath; // Use PIC1 as cover for now
+        assets.coverPath = bgPath; // Use PIC1 as cover unless there is a PIC0
+    }
+
+    if (!meta.overlayData.empty()) {
+        writeDataToFile(overlayPath, meta.overlayData);
+        assets.coverPath = overlayPath;
+    }
+
+    if (!meta.iconVideoData.empty()) {
+        writeDataToFile(pmfPath, meta.iconVideoData);
+        assets.iconVideoPath = iconVideoFor(pmfPath, iconVideoPath);
     }
 
     if (!meta.soundData.empty()) {
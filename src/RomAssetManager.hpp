@@ -4,9 +4,11 @@
 
 struct CachedAssets {
     std::string title;
+    std::string discId;    // DISC_ID from PARAM.SFO, e.g. "ULUS10041"
     std::string iconPath;
     std::string backgroundPath;
     std::string audioPath;
+    std::string iconVideoPath; // ICON1 video stream (raw H.264 demuxed from ICON1.PMF)
     std::string coverPath; // Usually same as background or PIC0
 };
 
@@ -0,0 +1,174 @@
+#include "RomPrefetcher.hpp"
+#include "PerfStats.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::uint64_t SECTOR_SIZE = 2048;
+constexpr std::uint64_t MAX_DIRECTORY_SIZE = 1024 * 1024; // Anything bigger is a corrupt record
+constexpr std::size_t READ_CHUNK = 1024 * 1024;
+
+struct DirectoryEntry {
+    std::uint64_t offset;
+    std::uint64_t size;
+    bool isDirectory;
+};
+
+std::uint32_t readLE32(const unsigned char* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+DirectoryEntry parseRecord(const unsigned char* record) {
+    return {readLE32(record + 2) * SECTOR_SIZE, readLE32(record + 10), (record[25] & 0x02) != 0};
+}
+
+bool sameName(std::string entryName, const std::string& wanted) {
+    // File identifiers carry a ";1" version suffix
+    const std::size_t version = entryName.find(';');
+    if (version != std::string::npos) entryName.resize(version);
+    return entryName.size() == wanted.size() &&
+           std::equal(entryName.begin(), entryName.end(), wanted.begin(), [](char a, char b) {
+               return std::toupper(static_cast<unsigned char>(a)) == std::toupper(static_cast<unsigned char>(b));
+           });
+}
+
+std::optional<DirectoryEntry> findEntry(std::istream& in, const DirectoryEntry& directory, const std::string& name) {
+    if (!directory.isDirectory || directory.size > MAX_DIRECTORY_SIZE) return std::nullopt;
+
+    std::vector<unsigned char> data(static_cast<std::size_t>(directory.size));
+    in.seekg(static_cast<std::streamoff>(directory.offset));
+    in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!in) return std::nullopt;
+
+    for (std::size_t pos = 0; pos < data.size();) {
+        const std::size_t length = data[pos];
+        if (length == 0) {
+            // Records never cross a sector; a zero length pads to the next one
+            pos = (pos / SECTOR_SIZE + 1) * SECTOR_SIZE;
+            continue;
+        }
+        if (length < 34 || pos + length > data.size()) break;
+
+        const std::size_t nameLength = data[pos + 32];
+        if (33 + nameLength > length) break;
+        const std::string entryName(reinterpret_cast<const char*>(&data[pos + 33]), nameLength);
+        if (sameName(entryName, name)) {
+            return parseRecord(&data[pos]);
+        }
+        pos += length;
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+void RomPrefetcher::start(const std::string& path, std::uint64_t headBytes) {
+    stop();
+    if (path.empty()) return;
+    cancel_ = false;
+    thread_ = std::thread(&RomPrefetcher::run, this, path, headBytes);
+}
+
+void RomPrefetcher::stop() {
+    cancel_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::vector<RomPrefetcher::Range> RomPrefetcher::findBootFiles(std::istream& in) {
+    // Primary volume descriptor: type 1, "CD001", root directory record at byte 156
+    unsigned char descriptor[SECTOR_SIZE];
+    in.seekg(static_cast<std::streamoff>(16 * SECTOR_SIZE));
+    in.read(reinterpret_cast<char*>(descriptor), sizeof(descriptor));
+    if (!in || descriptor[0] != 1 || std::memcmp(descriptor + 1, "CD001", 5) != 0) {
+        return {}; // Not a plain ISO (CSO, PBP, ...): the head alone will have to do
+    }
+
+    std::vector<Range> files;
+    const DirectoryEntry root = parseRecord(descriptor + 156);
+    const auto pspGame = findEntry(in, root, "PSP_GAME");
+    if (!pspGame) return files;
+
+    if (auto sfo = findEntry(in, *pspGame, "PARAM.SFO")) {
+        files.push_back({sfo->offset, sfo->size});
+    }
+    if (auto sysDir = findEntry(in, *pspGame, "SYSDIR")) {
+        for (const char* name : {"EBOOT.BIN", "BOOT.BIN"}) {
+            if (auto file = findEntry(in, *sysDir, name)) {
+                files.push_back({file->offset, file->size});
+            }
+        }
+    }
+    return files;
+}
+
+void RomPrefetcher::run(std::string path, std::uint64_t headBytes) {
+    const auto started = std::chrono::steady_clock::now();
+
+    std::ifstream in(std::filesystem::path(path), std::ios::binary);
+    if (!in) {
+        std::cerr << "RomPrefetcher: cannot open " << path << "\n";
+        return;
+    }
+    in.seekg(0, std::ios::end);
+    const std::uint64_t fileSize = static_cast<std::uint64_t>(in.tellg());
+
+    std::vector<Range> ranges = {{0, std::min(headBytes, fileSize)}};
+    const std::vector<Range> bootFiles = findBootFiles(in);
+    for (const Range& file : bootFiles) {
+        if (file.offset >= fileSize) continue;
+        const std::uint64_t end = std::min(file.offset + file.size, fileSize);
+        if (end > ranges[0].size) {
+            const std::uint64_t begin = std::max(file.offset, ranges[0].size);
+            ranges.push_back({begin, end - begin});
+        }
+    }
+    in.clear();
+
+#ifndef _WIN32
+    // Let the kernel start reading everything at once; the loop below then mostly hits the cache
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        for (const Range& range : ranges) {
+            posix_fadvise(fd, static_cast<off_t>(range.offset), static_cast<off_t>(range.size), POSIX_FADV_WILLNEED);
+        }
+        close(fd);
+    }
+#endif
+
+    // Reading pulls the pages in even where there is no readahead hint (Windows) or it is ignored
+    std::vector<char> buffer(READ_CHUNK);
+    std::uint64_t total = 0;
+    for (const Range& range : ranges) {
+        in.seekg(static_cast<std::streamoff>(range.offset));
+        std::uint64_t remaining = range.size;
+        while (remaining > 0 && !cancel_) {
+            const std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(remaining, buffer.size()));
+            in.read(buffer.data(), static_cast<std::streamsize>(chunk));
+            const std::uint64_t got = static_cast<std::uint64_t>(in.gcount());
+            if (got == 0) break;
+            total += got;
+            remaining -= got;
+        }
+        in.clear();
+    }
+
+    if (perf::enabled()) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+        std::cout << "[Launch] prefetched " << (total / (1024 * 1024)) << " MB (" << bootFiles.size()
+                  << " boot files) in " << elapsed.count() << " ms" << (cancel_ ? " (cancelled)" : "") << "\n";
+    }
+}
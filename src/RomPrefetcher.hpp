@@ -0,0 +1,34 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Warms the OS file cache for a game while the controller prompt and startup
+ * animation are on screen, so the emulator doesn't cold-read the ISO.
+ * Prefetches the first `headBytes` of the file plus the boot files found
+ * through the ISO9660 directory (PARAM.SFO, EBOOT.BIN, BOOT.BIN).
+ */
+class RomPrefetcher {
+public:
+    ~RomPrefetcher() { stop(); }
+
+    // Starts prefetching on a background thread, cancelling any earlier request
+    void start(const std::string& path, std::uint64_t headBytes);
+    void stop();
+
+private:
+    struct Range {
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    void run(std::string path, std::uint64_t headBytes);
+    static std::vector<Range> findBootFiles(std::istream& in);
+
+    std::atomic<bool> cancel_{false};
+    std::thread thread_;
+};
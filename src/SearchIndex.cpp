@@ -0,0 +1,278 @@
+#include "SearchIndex.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+const char INDEX_MAGIC[8] = {'P', 'S', 'P', 'T', 'R', 'I', 'G', '\0'};
+
+std::uint32_t packTrigram(const std::string& text, std::size_t i) {
+    return (static_cast<std::uint32_t>(static_cast<unsigned char>(text[i])) << 16) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(text[i + 1])) << 8) |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(text[i + 2]));
+}
+
+// Trigrams of `padded`, sorted and deduplicated
+std::vector<std::uint32_t> trigramsOf(const std::string& padded) {
+    std::vector<std::uint32_t> trigrams;
+    for (std::size_t i = 0; i + 3 <= padded.size(); ++i) {
+        trigrams.push_back(packTrigram(padded, i));
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+// Match quality of a normalized query against a normalized title / disc id
+int matchTier(const std::string& title, const std::string& id, const std::string& query) {
+    if (title == query || (!id.empty() && id == query)) return 5;
+    const std::size_t pos = title.find(query);
+    if (pos == 0) return 4;
+    if (pos != std::string::npos && title[pos - 1] == ' ') return 3;
+    if (!id.empty() && id.find(query) != std::string::npos) return 3;
+    if (pos != std::string::npos) return 2;
+    return 1;
+}
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+void writeString(std::ostream& out, const std::string& text) {
+    writeValue(out, static_cast<std::uint32_t>(text.size()));
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+bool readString(std::istream& in, std::string& text) {
+    std::uint32_t length = 0;
+    if (!readValue(in, length) || length > (1u << 16)) return false;
+    text.resize(length);
+    return static_cast<bool>(in.read(text.data(), length));
+}
+
+void writeArray(std::ostream& out, const std::vector<std::uint32_t>& values) {
+    writeValue(out, static_cast<std::uint32_t>(values.size()));
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(std::uint32_t)));
+}
+
+bool readArray(std::istream& in, std::vector<std::uint32_t>& values) {
+    std::uint32_t count = 0;
+    if (!readValue(in, count) || count > (1u << 26)) return false;
+    values.resize(count);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(std::uint32_t))));
+}
+
+} // namespace
+
+std::string SearchIndex::normalize(const std::string& text) {
+    // ASCII letters and digits are lowercased, UTF-8 bytes kept, everything else becomes one space
+    std::string normalized;
+    normalized.reserve(text.size());
+    bool pendingSpace = false;
+    for (char c : text) {
+        const unsigned char byte = static_cast<unsigned char>(c);
+        if (std::isalnum(byte) || byte >= 0x80) {
+            if (pendingSpace && !normalized.empty()) normalized.push_back(' ');
+            pendingSpace = false;
+            normalized.push_back(static_cast<char>(std::tolower(byte)));
+        } else {
+            pendingSpace = true;
+        }
+    }
+    return normalized;
+}
+
+std::uint64_t SearchIndex::fingerprint(const std::vector<Document>& documents) {
+    // FNV-1a over every title and id, with separators so ("ab", "c") != ("a", "bc")
+    std::uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](const std::string& text) {
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        hash ^= 0xff;
+        hash *= 1099511628211ull;
+    };
+    for (const Document& document : documents) {
+        mix(document.title);
+        mix(document.discId);
+    }
+    return hash ^ (documents.size() * 0x9e3779b97f4a7c15ull) ^ FORMAT_VERSION;
+}
+
+void SearchIndex::clear() {
+    titles_.clear();
+    ids_.clear();
+    keys_.clear();
+    offsets_.clear();
+    postings_.clear();
+}
+
+void SearchIndex::build(const std::vector<Document>& documents) {
+    clear();
+    titles_.reserve(documents.size());
+    ids_.reserve(documents.size());
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs; // (trigram, document)
+    for (std::size_t i = 0; i < documents.size(); ++i) {
+        titles_.push_back(normalize(documents[i].title));
+        ids_.push_back(normalize(documents[i].discId));
+
+        std::vector<std::uint32_t> trigrams = trigramsOf(" " + titles_.back() + " ");
+        if (!ids_.back().empty()) {
+            const std::vector<std::uint32_t> idTrigrams = trigramsOf(" " + ids_.back() + " ");
+            trigrams.insert(trigrams.end(), idTrigrams.begin(), idTrigrams.end());
+            std::sort(trigrams.begin(), trigrams.end());
+            trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+        }
+        for (std::uint32_t trigram : trigrams) {
+            pairs.emplace_back(trigram, static_cast<std::uint32_t>(i));
+        }
+    }
+
+    // Sorting by (trigram, document) lays the posting lists out back to back, each already sorted
+    std::sort(pairs.begin(), pairs.end());
+    postings_.reserve(pairs.size());
+    for (const auto& [trigram, document] : pairs) {
+        if (keys_.empty() || keys_.back() != trigram) {
+            keys_.push_back(trigram);
+            offsets_.push_back(static_cast<std::uint32_t>(postings_.size()));
+        }
+        postings_.push_back(document);
+    }
+    offsets_.push_back(static_cast<std::uint32_t>(postings_.size()));
+}
+
+const std::uint32_t* SearchIndex::postingsFor(std::uint32_t trigram, std::size_t& count) const {
+    const auto it = std::lower_bound(keys_.begin(), keys_.end(), trigram);
+    if (it == keys_.end() || *it != trigram) {
+        count = 0;
+        return nullptr;
+    }
+    const std::size_t k = static_cast<std::size_t>(it - keys_.begin());
+    count = offsets_[k + 1] - offsets_[k];
+    return postings_.data() + offsets_[k];
+}
+
+std::vector<SearchIndex::Result> SearchIndex::search(const std::string& query, std::size_t maxResults) const {
+    std::vector<Result> results;
+    const std::string needle = normalize(query);
+    if (needle.empty() || titles_.empty() || maxResults == 0) return results;
+
+    auto score = [&](std::size_t document, float trigramShare) {
+        const int tier = matchTier(titles_[document], ids_[document], needle);
+        return static_cast<float>(tier) * 10.f + trigramShare * 5.f -
+               std::min(static_cast<float>(titles_[document].size()), 200.f) * 0.01f;
+    };
+
+    if (needle.size() < 3) {
+        // Too short for a trigram of its own: a linear word-prefix scan is still well under a millisecond
+        for (std::size_t i = 0; i < titles_.size(); ++i) {
+            if (matchTier(titles_[i], ids_[i], needle) >= 3) {
+                results.push_back({i, score(i, 1.f)});
+            }
+        }
+    } else {
+        // Leading pad only: the last word of the query is usually still being typed
+        const std::vector<std::uint32_t> trigrams = trigramsOf(" " + needle);
+        std::vector<std::uint16_t> hits(titles_.size(), 0);
+        std::vector<std::uint32_t> touched;
+        for (std::uint32_t trigram : trigrams) {
+            std::size_t count = 0;
+            const std::uint32_t* documents = postingsFor(trigram, count);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (hits[documents[i]]++ == 0) touched.push_back(documents[i]);
+            }
+        }
+
+        // Allow roughly one typo per three trigrams before a title drops out
+        const std::size_t total = trigrams.size();
+        const std::size_t required = std::max<std::size_t>(1, (total * 6 + 9) / 10);
+        for (std::uint32_t document : touched) {
+            if (hits[document] >= required) {
+                results.push_back({document, score(document, static_cast<float>(hits[document]) / static_cast<float>(total))});
+            }
+        }
+    }
+
+    const auto better = [](const Result& a, const Result& b) {
+        return a.score != b.score ? a.score > b.score : a.index < b.index;
+    };
+    if (results.size() > maxResults) {
+        std::partial_sort(results.begin(), results.begin() + static_cast<std::ptrdiff_t>(maxResults), results.end(), better);
+        results.resize(maxResults);
+    } else {
+        std::sort(results.begin(), results.end(), better);
+    }
+    return results;
+}
+
+bool SearchIndex::save(const std::string& path, std::uint64_t fingerprint) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "SearchIndex: cannot write " << path << "\n";
+        return false;
+    }
+    out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    writeValue(out, FORMAT_VERSION);
+    writeValue(out, fingerprint);
+    writeValue(out, static_cast<std::uint32_t>(titles_.size()));
+    for (std::size_t i = 0; i < titles_.size(); ++i) {
+        writeString(out, titles_[i]);
+        writeString(out, ids_[i]);
+    }
+    writeArray(out, keys_);
+    writeArray(out, offsets_);
+    writeArray(out, postings_);
+    return static_cast<bool>(out);
+}
+
+bool SearchIndex::load(const std::string& path, std::uint64_t fingerprint) {
+    clear();
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    char magic[sizeof(INDEX_MAGIC)];
+    std::uint32_t version = 0;
+    std::uint64_t storedFingerprint = 0;
+    std::uint32_t count = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+        !readValue(in, version) || version != FORMAT_VERSION ||
+        !readValue(in, storedFingerprint) || storedFingerprint != fingerprint ||
+        !readValue(in, count)) {
+        return false;
+    }
+
+    titles_.resize(count);
+    ids_.resize(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (!readString(in, titles_[i]) || !readString(in, ids_[i])) {
+            clear();
+            return false;
+        }
+    }
+    // search() indexes by these without checking, so a damaged body must not get past here:
+    // keys strictly ascending (postingsFor() binary-searches them), offsets from 0 and never
+    // decreasing, and every posting a valid title
+    if (!readArray(in, keys_) || !readArray(in, offsets_) || !readArray(in, postings_) ||
+        offsets_.size() != keys_.size() + 1 || offsets_.front() != 0 || offsets_.back() != postings_.size() ||
+        !std::is_sorted(offsets_.begin(), offsets_.end()) ||
+        std::adjacent_find(keys_.begin(), keys_.end(), std::greater_equal<std::uint32_t>()) != keys_.end() ||
+        !std::all_of(postings_.begin(), postings_.end(), [count](std::uint32_t document) { return document < count; })) {
+        std::cerr << "SearchIndex: " << path << " is corrupt, rebuilding\n";
+        clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Trigram inverted index over game titles and disc IDs for type-ahead search.
+ *
+ * Titles are normalized (lowercase, punctuation folded to single spaces) and
+ * every trigram of " title " and " discid " maps to a sorted posting list of
+ * documents. A query only touches the posting lists of its own trigrams, so
+ * each keystroke costs a few thousand integer increments even for 20k titles.
+ * Results are ranked exact > prefix > word prefix > substring > fuzzy
+ * (most shared trigrams), shorter titles first within a tier.
+ */
+class SearchIndex {
+public:
+    struct Document {
+        std::string title;
+        std::string discId; // e.g. "ULUS10041"; may be empty
+    };
+
+    struct Result {
+        std::size_t index; // Position in the documents passed to build()
+        float score;
+    };
+
+    void build(const std::vector<Document>& documents);
+    void clear();
+    std::size_t size() const { return titles_.size(); }
+
+    std::vector<Result> search(const std::string& query, std::size_t maxResults) const;
+
+    // Binary snapshot; load() fails (and leaves the index empty) if the fingerprint doesn't match
+    bool save(const std::string& path, std::uint64_t fingerprint) const;
+    bool load(const std::string& path, std::uint64_t fingerprint);
+
+    // Cheap identity of a document list, to tell whether a saved index is still valid
+    static std::uint64_t fingerprint(const std::vector<Document>& documents);
+    static std::string normalize(const std::string& text);
+
+private:
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+    const std::uint32_t* postingsFor(std::uint32_t trigram, std::size_t& count) const;
+
+    std::vector<std::string> titles_; // Normalized
+    std::vector<std::string> ids_;    // Normalized
+    // Posting lists in CSR form: keys_[k]'s documents are postings_[offsets_[k] .. offsets_[k + 1])
+    std::vector<std::uint32_t> keys_;
+    std::vector<std::uint32_t> offsets_;
+    std::vector<std::uint32_t> postings_;
+};
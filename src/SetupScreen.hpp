@@ -17,6 +17,7 @@ public:
     void draw(sf::RenderWindow& window);
 
     bool isFinished() const { return finished_; }
+    bool isAnimating() const { return !finished_; } // Blinking text cursor
 
 private:
     void handleTextInput(char character);
@@ -0,0 +1,60 @@
+#include "TextCache.hpp"
+#include <functional>
+#include <iterator>
+
+std::size_t TextCache::KeyHash::operator()(const Key& key) const {
+    std::size_t h = std::hash<std::string>()(key.string);
+    h ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<unsigned int>()(key.characterSize) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+sf::Text& TextCache::get(const sf::Font& font, const std::string& string, unsigned int characterSize) {
+    Key key{&font, characterSize, string};
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        it = entries_.emplace(std::move(key), Entry{sf::Text(font, string, characterSize), frame_}).first;
+    }
+
+    Entry& entry = it->second;
+    entry.lastUsedFrame = frame_;
+
+    // Transform changes don't touch the glyph geometry, so resetting them is free
+    entry.text.setOrigin({0.f, 0.f});
+    entry.text.setScale({1.f, 1.f});
+    entry.text.setRotation(sf::degrees(0.f));
+    return entry.text;
+}
+
+sf::Text& TextCache::getScaled(const sf::Font& font, const std::string& string, float pixelSize) {
+    unsigned int base = QUANTIZED_SIZES[std::size(QUANTIZED_SIZES) - 1];
+    for (unsigned int size : QUANTIZED_SIZES) {
+        if (static_cast<float>(size) >= pixelSize) {
+            base = size;
+            break;
+        }
+    }
+    sf::Text& text = get(font, string, base);
+    const float scale = pixelSize / static_cast<float>(base);
+    text.setScale({scale, scale});
+    return text;
+}
+
+void TextCache::warmGlyphs(const sf::Font& font, const sf::String& characters, std::initializer_list<unsigned int> sizes) {
+    for (unsigned int size : sizes) {
+        for (char32_t c : characters) {
+            (void)font.getGlyph(c, size, false);
+        }
+    }
+}
+
+void TextCache::endFrame(std::uint64_t maxIdleFrames) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (frame_ - it->second.lastUsedFrame > maxIdleFrames) {
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ++frame_;
+}
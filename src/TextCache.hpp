@@ -0,0 +1,59 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Retained sf::Text objects keyed by (string, font, character size).
+ * sf::Text rebuilds its glyph quads whenever the string, font or size changes,
+ * so constructing one per label per frame redoes that layout 60 times a second.
+ * Entries here keep their vertex geometry between frames; colour and transform
+ * changes made by the caller are cheap. Entries not used for a while are swept.
+ */
+class TextCache {
+public:
+    // Returns the retained text with its transform reset (origin 0, scale 1, no rotation).
+    // The reference stays valid until the next sweep in endFrame().
+    sf::Text& get(const sf::Font& font, const std::string& string, unsigned int characterSize);
+
+    // For animated sizes: renders at the nearest quantized size at or above pixelSize and scales
+    // down to match, so a growing label reuses one glyph page instead of rasterizing every size.
+    sf::Text& getScaled(const sf::Font& font, const std::string& string, float pixelSize);
+
+    // Rasterizes every glyph of `characters` at each size up front so none is rendered mid-animation
+    static void warmGlyphs(const sf::Font& font, const sf::String& characters, std::initializer_list<unsigned int> sizes);
+
+    // Character sizes getScaled() renders at
+    static constexpr unsigned int QUANTIZED_SIZES[] = {14, 18, 24, 32};
+
+    // Call once per frame after drawing. Drops entries unused for more than maxIdleFrames frames.
+    void endFrame(std::uint64_t maxIdleFrames = 120);
+
+    void clear() { entries_.clear(); }
+    std::size_t size() const { return entries_.size(); }
+
+private:
+    struct Key {
+        const sf::Font* font;
+        unsigned int characterSize;
+        std::string string;
+
+        bool operator==(const Key& other) const {
+            return font == other.font && characterSize == other.characterSize && string == other.string;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        sf::Text text;
+        std::uint64_t lastUsedFrame;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+    std::uint64_t frame_ = 0;
+};
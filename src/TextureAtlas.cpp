@@ -0,0 +1,201 @@
+#include "TextureAtlas.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Area-average downscale of an RGBA image so its longest edge is maxEdge
+std::vector<std::uint8_t> downscaleToFit(const sf::Image& image, unsigned int maxEdge, sf::Vector2u& sizeOut) {
+    const sf::Vector2u src = image.getSize();
+    const float ratio = static_cast<float>(maxEdge) / static_cast<float>(std::max(src.x, src.y));
+    sizeOut = {std::max(1u, static_cast<unsigned int>(src.x * ratio)),
+               std::max(1u, static_cast<unsigned int>(src.y * ratio))};
+
+    const std::uint8_t* in = image.getPixelsPtr();
+    std::vector<std::uint8_t> out(static_cast<std::size_t>(sizeOut.x) * sizeOut.y * 4);
+
+    for (unsigned int y = 0; y < sizeOut.y; ++y) {
+        const unsigned int y0 = y * src.y / sizeOut.y;
+        const unsigned int y1 = std::max(y0 + 1, (y + 1) * src.y / sizeOut.y);
+        for (unsigned int x = 0; x < sizeOut.x; ++x) {
+            const unsigned int x0 = x * src.x / sizeOut.x;
+            const unsigned int x1 = std::max(x0 + 1, (x + 1) * src.x / sizeOut.x);
+            unsigned int sum[4] = {0, 0, 0, 0};
+            for (unsigned int sy = y0; sy < y1; ++sy) {
+                const std::uint8_t* row = in + (static_cast<std::size_t>(sy) * src.x + x0) * 4;
+                for (unsigned int sx = x0; sx < x1; ++sx, row += 4) {
+                    sum[0] += row[0];
+                    sum[1] += row[1];
+                    sum[2] += row[2];
+                    sum[3] += row[3];
+                }
+            }
+            const unsigned int count = (x1 - x0) * (y1 - y0);
+            std::uint8_t* dst = &out[(static_cast<std::size_t>(y) * sizeOut.x + x) * 4];
+            for (int c = 0; c < 4; ++c) {
+                dst[c] = static_cast<std::uint8_t>(sum[c] / count);
+            }
+        }
+    }
+    return out;
+}
+
+// Copies pixels into a buffer with `pad` texels of clamped border on every side,
+// so linear filtering at the region edge never samples a neighbouring icon
+std::vector<std::uint8_t> extrude(const std::uint8_t* pixels, sf::Vector2u size, unsigned int pad) {
+    const unsigned int outW = size.x + pad * 2;
+    const unsigned int outH = size.y + pad * 2;
+    std::vector<std::uint8_t> out(static_cast<std::size_t>(outW) * outH * 4);
+    for (unsigned int y = 0; y < outH; ++y) {
+        const unsigned int sy = std::min(size.y - 1, y > pad ? y - pad : 0u);
+        for (unsigned int x = 0; x < outW; ++x) {
+            const unsigned int sx = std::min(size.x - 1, x > pad ? x - pad : 0u);
+            const std::uint8_t* s = pixels + (static_cast<std::size_t>(sy) * size.x + sx) * 4;
+            std::copy(s, s + 4, &out[(static_cast<std::size_t>(y) * outW + x) * 4]);
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+TextureAtlas::TextureAtlas(unsigned int pageSize, unsigned int maxEdge, unsigned int padding)
+    : pageSize_(std::min(pageSize, sf::Texture::getMaximumSize()))
+    , maxEdge_(maxEdge)
+    , padding_(padding) {
+}
+
+const AtlasRegion* TextureAtlas::find(const std::string& key) const {
+    auto it = regions_.find(key);
+    return it != regions_.end() ? &it->second : nullptr;
+}
+
+const AtlasRegion* TextureAtlas::addFromFile(const std::string& key, const std::string& path, unsigned int maxEdge) {
+    if (const AtlasRegion* existing = find(key)) return existing;
+
+    sf::Image image;
+    if (!image.loadFromFile(path)) {
+        std::cerr << "TextureAtlas: failed to load " << path << "\n";
+        return nullptr;
+    }
+    return add(key, image, maxEdge);
+}
+
+const AtlasRegion* TextureAtlas::add(const std::string& key, const sf::Image& image, unsigned int maxEdge) {
+    if (const AtlasRegion* existing = find(key)) return existing;
+
+    sf::Vector2u size = image.getSize();
+    if (size.x == 0 || size.y == 0) return nullptr;
+
+    const unsigned int limit = maxEdge ? maxEdge : maxEdge_;
+    std::vector<std::uint8_t> scaled;
+    const std::uint8_t* pixels = image.getPixelsPtr();
+    if (size.x > limit || size.y > limit) {
+        scaled = downscaleToFit(image, limit, size);
+        pixels = scaled.data();
+    }
+
+    const sf::Vector2u padded = {size.x + padding_ * 2, size.y + padding_ * 2};
+    std::size_t page = 0;
+    sf::Vector2u pos;
+    if (!allocate(padded, page, pos)) {
+        std::cerr << "TextureAtlas: no room for " << key << "\n";
+        return nullptr;
+    }
+
+    std::vector<std::uint8_t> bordered = extrude(pixels, size, padding_);
+    pages_[page]->texture.update(bordered.data(), padded, pos);
+
+    AtlasRegion region;
+    region.page = page;
+    region.rect = sf::IntRect({static_cast<int>(pos.x + padding_), static_cast<int>(pos.y + padding_)},
+                              {static_cast<int>(size.x), static_cast<int>(size.y)});
+    return &regions_.emplace(key, region).first->second;
+}
+
+bool TextureAtlas::allocate(sf::Vector2u size, std::size_t& pageOut, sf::Vector2u& posOut) {
+    if (size.x > pageSize_ || size.y > pageSize_) return false;
+
+    for (std::size_t i = 0; i < pages_.size(); ++i) {
+        if (tryAllocateOnPage(*pages_[i], size, posOut)) {
+            pageOut = i;
+            return true;
+        }
+    }
+
+    Page* page = addPage();
+    if (!page || !tryAllocateOnPage(*page, size, posOut)) return false;
+    pageOut = pages_.size() - 1;
+    return true;
+}
+
+bool TextureAtlas::tryAllocateOnPage(Page& page, sf::Vector2u size, sf::Vector2u& posOut) {
+    // Best fit among existing shelves that are tall enough without wasting more than a quarter
+    Shelf* best = nullptr;
+    for (auto& shelf : page.shelves) {
+        if (shelf.height < size.y || shelf.height > size.y + size.y / 4) continue;
+        if (shelf.cursorX + size.x > pageSize_) continue;
+        if (!best || shelf.height < best->height) best = &shelf;
+    }
+
+    if (!best) {
+        if (page.nextShelfY + size.y > pageSize_) return false;
+        page.shelves.push_back({page.nextShelfY, size.y, 0});
+        page.nextShelfY += size.y;
+        best = &page.shelves.back();
+    }
+
+    posOut = {best->cursorX, best->y};
+    best->cursorX += size.x;
+    return true;
+}
+
+TextureAtlas::Page* TextureAtlas::addPage() {
+    auto page = std::make_unique<Page>();
+    if (!page->texture.resize({pageSize_, pageSize_})) {
+        std::cerr << "TextureAtlas: failed to create " << pageSize_ << "x" << pageSize_ << " page\n";
+        return nullptr;
+    }
+    page->texture.setSmooth(true);
+    pages_.push_back(std::move(page));
+    std::cout << "TextureAtlas: allocated page " << pages_.size() << " (" << pageSize_ << "x" << pageSize_ << ")\n";
+    return pages_.back().get();
+}
+
+void AtlasBatch::clear() {
+    for (auto& vertices : pages_) {
+        vertices.clear();
+    }
+}
+
+void AtlasBatch::add(const AtlasRegion& region, sf::Vector2f center, sf::Vector2f size, sf::Color color) {
+    if (pages_.size() <= region.page) {
+        pages_.resize(region.page + 1, sf::VertexArray(sf::PrimitiveType::Triangles));
+    }
+
+    const sf::Vector2f half = size / 2.f;
+    const sf::Vector2f tl = center - half;
+    const sf::Vector2f br = center + half;
+    const sf::Vector2f uv0(region.rect.position);
+    const sf::Vector2f uv1(region.rect.position + region.rect.size);
+
+    sf::VertexArray& v = pages_[region.page];
+    v.append({{tl.x, tl.y}, color, {uv0.x, uv0.y}});
+    v.append({{br.x, tl.y}, color, {uv1.x, uv0.y}});
+    v.append({{tl.x, br.y}, color, {uv0.x, uv1.y}});
+    v.append({{tl.x, br.y}, color, {uv0.x, uv1.y}});
+    v.append({{br.x, tl.y}, color, {uv1.x, uv0.y}});
+    v.append({{br.x, br.y}, color, {uv1.x, uv1.y}});
+}
+
+std::size_t AtlasBatch::draw(sf::RenderTarget& target) const {
+    std::size_t calls = 0;
+    for (std::size_t i = 0; i < pages_.size() && i < atlas_.pageCount(); ++i) {
+        if (pages_[i].getVertexCount() == 0) continue;
+        sf::RenderStates states;
+        states.texture = &atlas_.pageTexture(i);
+        target.draw(pages_[i], states);
+        ++calls;
+    }
+    return calls;
+}
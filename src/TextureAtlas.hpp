@@ -0,0 +1,83 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * Location of one packed image inside a TextureAtlas.
+ * `rect` is in texels of page `page` and excludes the padding border.
+ */
+struct AtlasRegion {
+    std::size_t page = 0;
+    sf::IntRect rect;
+};
+
+/**
+ * Packs many small images (menu icons, ICON0 thumbnails) into a handful of
+ * large textures using a shelf packer, so they can be drawn with one
+ * vertex array per page instead of one sprite (and texture bind) each.
+ * Pages are added on demand, so the atlas can keep growing while games are
+ * discovered.
+ */
+class TextureAtlas {
+public:
+    // maxEdge: images larger than this on either axis are box-downscaled before packing
+    explicit TextureAtlas(unsigned int pageSize = 2048, unsigned int maxEdge = 256, unsigned int padding = 2);
+
+    // Returns the region for key if already packed, otherwise nullptr
+    const AtlasRegion* find(const std::string& key) const;
+
+    // Packs image under key (no-op if key already exists). Returns nullptr if it cannot fit.
+    // maxEdge overrides the atlas-wide downscale limit when non-zero.
+    const AtlasRegion* add(const std::string& key, const sf::Image& image, unsigned int maxEdge = 0);
+    const AtlasRegion* addFromFile(const std::string& key, const std::string& path, unsigned int maxEdge = 0);
+
+    std::size_t pageCount() const { return pages_.size(); }
+    const sf::Texture& pageTexture(std::size_t page) const { return pages_[page]->texture; }
+
+private:
+    struct Shelf {
+        unsigned int y;
+        unsigned int height;
+        unsigned int cursorX;
+    };
+
+    struct Page {
+        sf::Texture texture;
+        std::vector<Shelf> shelves;
+        unsigned int nextShelfY = 0;
+    };
+
+    bool allocate(sf::Vector2u size, std::size_t& pageOut, sf::Vector2u& posOut);
+    bool tryAllocateOnPage(Page& page, sf::Vector2u size, sf::Vector2u& posOut);
+    Page* addPage();
+
+    unsigned int pageSize_;
+    unsigned int maxEdge_;
+    unsigned int padding_;
+    std::vector<std::unique_ptr<Page>> pages_;
+    std::unordered_map<std::string, AtlasRegion> regions_;
+};
+
+/**
+ * Per-frame quad batch over a TextureAtlas: one sf::VertexArray per page,
+ * drawn with a single draw call each.
+ */
+class AtlasBatch {
+public:
+    explicit AtlasBatch(const TextureAtlas& atlas) : atlas_(atlas) {}
+
+    void clear();
+
+    // Adds a quad of the given on-screen size centered on `center`
+    void add(const AtlasRegion& region, sf::Vector2f center, sf::Vector2f size, sf::Color color = sf::Color::White);
+
+    // Draws every non-empty page; returns the number of draw calls issued
+    std::size_t draw(sf::RenderTarget& target) const;
+
+private:
+    const TextureAtlas& atlas_;
+    std::vector<sf::VertexArray> pages_;
+};
@@ -0,0 +1,190 @@
+#include "TextureCache.hpp"
+#include <algorithm>
+#include <iostream>
+
+TextureCache::TextureCache(std::size_t budgetBytes)
+    : budgetBytes_(budgetBytes)
+    , worker_(&TextureCache::workerLoop, this) {
+}
+
+TextureCache::~TextureCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+const sf::Texture* TextureCache::get(const std::string& path) {
+    if (path.empty()) return nullptr;
+
+    auto it = resident_.find(path);
+    if (it == resident_.end()) {
+        request(path, -1); // Needed on screen right now
+        return nullptr;
+    }
+    it->second.lastUsed = ++useCounter_;
+    return &it->second.texture;
+}
+
+const sf::Texture* TextureCache::find(const std::string& path) {
+    auto it = resident_.find(path);
+    if (it == resident_.end()) return nullptr;
+    it->second.lastUsed = ++useCounter_;
+    return &it->second.texture;
+}
+
+void TextureCache::request(const std::string& path, int priority) {
+    if (path.empty() || resident_.count(path) || failed_.count(path)) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (inFlight_.count(path)) {
+            // Already on its way; just bump the priority if it is still queued
+            for (auto& req : queue_) {
+                if (req.path == path) {
+                    req.priority = std::min(req.priority, priority);
+                    break;
+                }
+            }
+            return;
+        }
+        queue_.push_back({path, priority});
+        inFlight_.insert(path);
+    }
+    cv_.notify_one();
+}
+
+void TextureCache::setResidencyWindow(const std::vector<std::string>& pinned, const std::vector<std::string>& fetch) {
+    pinned_.clear();
+    for (const auto& path : pinned) {
+        if (!path.empty()) pinned_.insert(path);
+    }
+
+    {
+        std::unordered_map<std::string, int> wanted;
+        for (std::size_t i = 0; i < fetch.size(); ++i) {
+            wanted.emplace(fetch[i], static_cast<int>(i));
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Drop stale requests (scrolled past, or ahead of a cursor that reversed) before the worker reaches them,
+        // and re-rank the survivors so the old direction of travel doesn't keep its head start
+        queue_.erase(std::remove_if(queue_.begin(), queue_.end(), [&](Request& req) {
+            auto it = wanted.find(req.path);
+            if (it != wanted.end()) {
+                req.priority = it->second;
+                return false;
+            }
+            inFlight_.erase(req.path);
+            return true;
+        }), queue_.end());
+    }
+
+    for (std::size_t i = 0; i < fetch.size(); ++i) {
+        request(fetch[i], static_cast<int>(i));
+    }
+}
+
+void TextureCache::update(std::size_t maxUploads) {
+    for (std::size_t uploads = 0; uploads < maxUploads; ++uploads) {
+        Decoded done;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (decoded_.empty()) break;
+            done = std::move(decoded_.front());
+            decoded_.pop_front();
+            inFlight_.erase(done.path);
+        }
+
+        if (!done.image) {
+            failed_.insert(done.path);
+            continue;
+        }
+
+        Entry entry;
+        if (!entry.texture.loadFromImage(*done.image)) {
+            std::cerr << "TextureCache: failed to upload " << done.path << "\n";
+            failed_.insert(done.path);
+            continue;
+        }
+        entry.texture.setSmooth(true);
+        const sf::Vector2u size = entry.texture.getSize();
+        entry.bytes = static_cast<std::size_t>(size.x) * size.y * 4;
+        entry.lastUsed = ++useCounter_;
+        residentBytes_ += entry.bytes;
+        resident_.emplace(done.path, std::move(entry));
+    }
+
+    evictToBudget();
+}
+
+void TextureCache::clear() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& req : queue_) {
+            inFlight_.erase(req.path);
+        }
+        for (const auto& done : decoded_) {
+            inFlight_.erase(done.path);
+        }
+        queue_.clear();
+        decoded_.clear();
+        // Anything left in inFlight_ is being decoded right now and is uploaded as usual
+    }
+    resident_.clear();
+    pinned_.clear();
+    residentBytes_ = 0;
+}
+
+bool TextureCache::hasPendingWork() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !inFlight_.empty();
+}
+
+void TextureCache::evictToBudget() {
+    while (residentBytes_ > budgetBytes_) {
+        auto victim = resident_.end();
+        for (auto it = resident_.begin(); it != resident_.end(); ++it) {
+            if (pinned_.count(it->first)) continue;
+            if (victim == resident_.end() || it->second.lastUsed < victim->second.lastUsed) {
+                victim = it;
+            }
+        }
+        if (victim == resident_.end()) break; // Everything left is inside the window
+
+        residentBytes_ -= victim->second.bytes;
+        resident_.erase(victim);
+    }
+}
+
+void TextureCache::workerLoop() {
+    while (true) {
+        Request req;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+            if (stop_) return;
+
+            auto next = std::min_element(queue_.begin(), queue_.end(), [](const Request& a, const Request& b) {
+                return a.priority < b.priority;
+            });
+            req = std::move(*next);
+            queue_.erase(next);
+        }
+
+        Decoded done;
+        done.path = req.path;
+        sf::Image image;
+        if (image.loadFromFile(req.path)) {
+            done.image = std::move(image);
+        } else {
+            std::cerr << "TextureCache: failed to decode " << req.path << "\n";
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        decoded_.push_back(std::move(done));
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+#include <optional>
+
+/**
+ * On-demand texture residency for preview art (ICON0, PIC1, cover art).
+ * Images are decoded on a worker thread and uploaded on the render thread a
+ * few per frame. Paths inside the current residency window are pinned; once
+ * the resident total exceeds the memory budget, the least recently used
+ * unpinned textures are evicted.
+ */
+class TextureCache {
+public:
+    explicit TextureCache(std::size_t budgetBytes);
+    ~TextureCache();
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    void setBudget(std::size_t budgetBytes) { budgetBytes_ = budgetBytes; }
+
+    // Returns the texture if it is resident, otherwise nullptr (and requests it)
+    const sf::Texture* get(const std::string& path);
+
+    // Like get(), but never queues a decode
+    const sf::Texture* find(const std::string& path);
+
+    // Queues an async decode unless the path is resident or already queued.
+    // Lower priority values are decoded first.
+    void request(const std::string& path, int priority = 0);
+
+    // Pins exactly these paths (ordered nearest-first) and requests the missing ones.
+    // Queued decodes for paths outside the window are dropped.
+    void setResidencyWindow(const std::vector<std::string>& paths) { setResidencyWindow(paths, paths); }
+
+    // Pins `pinned` against eviction, requests `fetch` in order and drops every other queued decode.
+    // Lets callers keep art that is already resident without paying to decode more of it.
+    void setResidencyWindow(const std::vector<std::string>& pinned, const std::vector<std::string>& fetch);
+
+    // Render thread: uploads finished decodes and evicts down to the budget
+    void update(std::size_t maxUploads = 4);
+
+    // Drops every resident texture and queued decode (the failed list is kept)
+    void clear();
+
+    // True while decodes are queued, running or waiting for upload
+    bool hasPendingWork();
+
+    // True once `path` failed to decode or upload; it will never become resident
+    bool hasFailed(const std::string& path) const { return failed_.count(path) != 0; }
+
+    std::size_t residentBytes() const { return residentBytes_; }
+    std::size_t residentCount() const { return resident_.size(); }
+
+private:
+    struct Entry {
+        sf::Texture texture;
+        std::size_t bytes = 0;
+        std::uint64_t lastUsed = 0;
+    };
+
+    struct Request {
+        std::string path;
+        int priority;
+    };
+
+    struct Decoded {
+        std::string path;
+        std::optional<sf::Image> image; // empty when decoding failed
+    };
+
+    void workerLoop();
+    void evictToBudget();
+
+    std::unordered_map<std::string, Entry> resident_;
+    std::unordered_set<std::string> pinned_;
+    std::unordered_set<std::string> failed_;  // never retried
+    std::size_t residentBytes_ = 0;
+    std::size_t budgetBytes_;
+    std::uint64_t useCounter_ = 0;
+
+    // Shared with the worker
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Request> queue_;
+    std::unordered_set<std::string> inFlight_; // queued, decoding or decoded but not uploaded
+    std::deque<Decoded> decoded_;
+    bool stop_ = false;
+    std::thread worker_;
+};
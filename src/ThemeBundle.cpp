@@ -0,0 +1,189 @@
+#include "ThemeBundle.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char BUNDLE_MAGIC[8] = {'P', 'S', 'P', 'C', 'T', 'H', 'M', '\0'};
+constexpr std::uint32_t FORMAT_VERSION = 2; // 1 also embedded the background image file
+constexpr std::uint32_t MAX_STRING = 1u << 12;
+constexpr std::uint32_t MAX_SIDE = 8192;
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeString(std::ostream& out, const std::string& text) {
+    writeValue(out, static_cast<std::uint32_t>(text.size()));
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+void writeColor(std::ostream& out, sf::Color color) {
+    const std::uint8_t rgba[4] = {color.r, color.g, color.b, color.a};
+    out.write(reinterpret_cast<const char*>(rgba), sizeof(rgba));
+}
+
+// Walks the loaded file; every read is bounds-checked, and one failure fails the rest
+class Reader {
+public:
+    explicit Reader(const std::vector<std::uint8_t>& data) : data_(data) {}
+
+    bool ok() const { return ok_; }
+    std::size_t offset() const { return offset_; }
+    std::size_t remaining() const { return ok_ ? data_.size() - offset_ : 0; }
+
+    bool bytes(void* out, std::size_t size) {
+        if (!ok_ || data_.size() - offset_ < size) return ok_ = false;
+        std::memcpy(out, data_.data() + offset_, size);
+        offset_ += size;
+        return true;
+    }
+
+    template <typename T>
+    T value() {
+        T value{};
+        bytes(&value, sizeof(value));
+        return value;
+    }
+
+    std::string string() {
+        const std::uint32_t length = value<std::uint32_t>();
+        if (!ok_ || length > MAX_STRING || remaining() < length) {
+            ok_ = false;
+            return std::string();
+        }
+        std::string text(reinterpret_cast<const char*>(data_.data() + offset_), length);
+        offset_ += length;
+        return text;
+    }
+
+    sf::Color color() {
+        std::uint8_t rgba[4] = {0, 0, 0, 0};
+        bytes(rgba, sizeof(rgba));
+        return sf::Color(rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
+
+private:
+    const std::vector<std::uint8_t>& data_;
+    std::size_t offset_ = 0;
+    bool ok_ = true;
+};
+
+} // namespace
+
+bool ThemeBundle::save(const std::string& path, const CustomTheme& theme, const sf::Image& background) {
+    // Written aside and renamed, so a half-written bundle is never picked up
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "ThemeBundle: cannot write " << path << "\n";
+            return false;
+        }
+        out.write(BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC));
+        writeValue(out, FORMAT_VERSION);
+
+        writeString(out, theme.name);
+        const ThemeColors& colors = theme.colors;
+        for (sf::Color color : {colors.primary, colors.secondary, colors.accent, colors.textPrimary,
+                                colors.textSecondary, colors.iconTint}) {
+            writeColor(out, color);
+        }
+        writeValue(out, static_cast<std::uint8_t>(theme.gradient.enabled));
+        writeColor(out, theme.gradient.startColor);
+        writeColor(out, theme.gradient.endColor);
+        writeValue(out, theme.gradient.angle);
+        writeString(out, theme.pattern.type);
+        writeColor(out, theme.pattern.color);
+        writeValue(out, theme.pattern.intensity);
+        writeValue(out, theme.pattern.scale);
+        writeString(out, theme.backgroundImage);
+        writeValue(out, theme.backgroundAlpha);
+
+        const sf::Vector2u size = background.getSize();
+        writeValue(out, size.x);
+        writeValue(out, size.y);
+        out.write(reinterpret_cast<const char*>(background.getPixelsPtr()),
+                  static_cast<std::streamsize>(static_cast<std::size_t>(size.x) * size.y * 4));
+        if (!out) {
+            out.close();
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            std::cerr << "ThemeBundle: failed writing " << path << "\n";
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        std::cerr << "ThemeBundle: cannot replace " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool ThemeBundle::load(const std::string& path) {
+    data_.clear();
+    backgroundSize_ = {0, 0};
+    pixelsOffset_ = 0;
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const std::streamoff fileSize = in.tellg();
+    if (fileSize <= 0) return false;
+    data_.resize(static_cast<std::size_t>(fileSize));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(data_.data()), fileSize)) {
+        std::cerr << "ThemeBundle: cannot read " << path << "\n";
+        data_.clear();
+        return false;
+    }
+
+    Reader reader(data_);
+    char magic[sizeof(BUNDLE_MAGIC)];
+    if (!reader.bytes(magic, sizeof(magic)) || std::memcmp(magic, BUNDLE_MAGIC, sizeof(magic)) != 0 ||
+        reader.value<std::uint32_t>() != FORMAT_VERSION) {
+        std::cerr << "ThemeBundle: " << path << " is not a version " << FORMAT_VERSION << " theme bundle\n";
+        data_.clear();
+        return false;
+    }
+
+    CustomTheme theme;
+    theme.name = reader.string();
+    ThemeColors& colors = theme.colors;
+    for (sf::Color* color : {&colors.primary, &colors.secondary, &colors.accent, &colors.textPrimary,
+                             &colors.textSecondary, &colors.iconTint}) {
+        *color = reader.color();
+    }
+    theme.gradient.enabled = reader.value<std::uint8_t>() != 0;
+    theme.gradient.startColor = reader.color();
+    theme.gradient.endColor = reader.color();
+    theme.gradient.angle = reader.value<float>();
+    theme.pattern.type = reader.string();
+    theme.pattern.color = reader.color();
+    theme.pattern.intensity = reader.value<float>();
+    theme.pattern.scale = reader.value<float>();
+    theme.backgroundImage = reader.string();
+    theme.backgroundAlpha = reader.value<float>();
+
+    const std::uint32_t width = reader.value<std::uint32_t>();
+    const std::uint32_t height = reader.value<std::uint32_t>();
+    const std::uint64_t pixelBytes = static_cast<std::uint64_t>(width) * height * 4;
+    if (!reader.ok() || width == 0 || height == 0 || width > MAX_SIDE || height > MAX_SIDE ||
+        reader.remaining() != pixelBytes) {
+        std::cerr << "ThemeBundle: " << path << " is truncated or corrupt\n";
+        data_.clear();
+        return false;
+    }
+
+    theme_ = std::move(theme);
+    backgroundSize_ = {width, height};
+    pixelsOffset_ = reader.offset();
+    return true;
+}
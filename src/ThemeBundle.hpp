@@ -0,0 +1,38 @@
+#pragma once
+#include "CustomThemeCreator.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * A saved custom theme (.ctheme): the creator's palette, gradient and
+ * pattern settings and the background already rendered from them. Applying
+ * a theme is one read of the whole file and one texture upload straight
+ * from the buffer; the gradient and pattern are never rendered again and
+ * nothing is decoded.
+ *
+ * Values are written in native byte order (like SearchIndex), followed by
+ * the raw RGBA background.
+ */
+class ThemeBundle {
+public:
+    static constexpr const char* EXTENSION = ".ctheme";
+
+    // Writes `theme` with its rendered `background`
+    static bool save(const std::string& path, const CustomTheme& theme, const sf::Image& background);
+
+    // Reads the whole bundle in one go; false if it is missing, from another version or truncated
+    bool load(const std::string& path);
+
+    const CustomTheme& theme() const { return theme_; }
+    sf::Vector2u backgroundSize() const { return backgroundSize_; }
+    // RGBA rows, backgroundSize() large; points into the loaded file
+    const std::uint8_t* backgroundPixels() const { return data_.data() + pixelsOffset_; }
+
+private:
+    std::vector<std::uint8_t> data_;
+    CustomTheme theme_;
+    sf::Vector2u backgroundSize_;
+    std::size_t pixelsOffset_ = 0;
+};
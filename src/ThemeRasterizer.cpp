@@ -0,0 +1,347 @@
+#include "ThemeRasterizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define THEMERASTER_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define THEMERASTER_NEON 1
+#endif
+
+namespace themeraster {
+
+namespace {
+
+constexpr float PI = 3.14159265f;
+
+// 4x4 Bayer matrix; threshold (2b+1)/32 of a level, so the dither averages to round-to-nearest
+constexpr std::uint8_t BAYER[4][4] = {
+    {0, 8, 2, 10},
+    {12, 4, 14, 6},
+    {3, 11, 1, 9},
+    {15, 7, 13, 5}
+};
+
+std::int32_t ditherAt(unsigned int x, unsigned int y) {
+    return (BAYER[y & 3][x & 3] * 2 + 1) << 11;
+}
+
+// Pixels [x, width) of a gradient row
+void gradientSpan(std::uint8_t* out, unsigned int x, unsigned int width, const std::int32_t start[4],
+                  const std::int32_t step[4], unsigned int y) {
+    for (; x < width; ++x) {
+        const std::int32_t dither = ditherAt(x, y);
+        for (int c = 0; c < 4; ++c) {
+            const std::int32_t value = (start[c] + static_cast<std::int32_t>(x) * step[c] + dither) >> 16;
+            out[x * 4 + c] = static_cast<std::uint8_t>(std::clamp(value, 0, 255));
+        }
+    }
+}
+
+// Pixels [x, width) of a blended row; t / 255 rounded is (t + 128 + ((t + 128) >> 8)) >> 8 for t <= 255 * 255
+void blendSpan(std::uint8_t* pixels, const std::uint8_t* coverage, unsigned int x, unsigned int width,
+               const std::uint8_t color[4]) {
+    for (; x < width; ++x) {
+        const unsigned int a = coverage[x];
+        for (int c = 0; c < 4; ++c) {
+            const unsigned int t = pixels[x * 4 + c] * (255 - a) + color[c] * a + 128;
+            pixels[x * 4 + c] = static_cast<std::uint8_t>((t + (t >> 8)) >> 8);
+        }
+    }
+}
+
+#if defined(THEMERASTER_SSE2)
+
+// 4 pixels per iteration, one 32-bit lane per channel; the packs saturate, which is the clamp
+void gradientRowImpl(std::uint8_t* out, unsigned int width, const std::int32_t start[4], const std::int32_t step[4],
+                     unsigned int y) {
+    __m128i value[4];
+    __m128i dither[4];
+    for (int i = 0; i < 4; ++i) {
+        value[i] = _mm_setr_epi32(start[0] + i * step[0], start[1] + i * step[1], start[2] + i * step[2],
+                                  start[3] + i * step[3]);
+        dither[i] = _mm_set1_epi32(ditherAt(i, y));
+    }
+    const __m128i advance = _mm_setr_epi32(step[0] * 4, step[1] * 4, step[2] * 4, step[3] * 4);
+
+    unsigned int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m128i level[4];
+        for (int i = 0; i < 4; ++i) {
+            level[i] = _mm_srai_epi32(_mm_add_epi32(value[i], dither[i]), 16);
+            value[i] = _mm_add_epi32(value[i], advance);
+        }
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(level[0], level[1]), _mm_packs_epi32(level[2], level[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), packed);
+    }
+    gradientSpan(out, x, width, start, step, y);
+}
+
+// 4 pixels per iteration, 16 bits per channel
+void blendRowImpl(std::uint8_t* pixels, const std::uint8_t* coverage, unsigned int width, const std::uint8_t color[4]) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i rounding = _mm_set1_epi16(128);
+    const __m128i colorWide = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color[0] | (color[1] << 8) |
+                                                                                (color[2] << 16) |
+                                                                                (static_cast<unsigned int>(color[3]) << 24))),
+                                                zero);
+
+    // Channels of two pixels in 16-bit lanes, blended by their coverages
+    auto blend = [&](__m128i dst, __m128i alpha) {
+        __m128i t = _mm_add_epi16(_mm_mullo_epi16(dst, _mm_sub_epi16(full, alpha)), _mm_mullo_epi16(colorWide, alpha));
+        t = _mm_add_epi16(t, rounding);
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    };
+
+    unsigned int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        // Each coverage byte repeated for the pixel's four channels
+        __m128i alpha = _mm_cvtsi32_si128(static_cast<int>(coverage[x] | (coverage[x + 1] << 8) | (coverage[x + 2] << 16) |
+                                                           (static_cast<unsigned int>(coverage[x + 3]) << 24)));
+        alpha = _mm_unpacklo_epi8(alpha, alpha);
+        alpha = _mm_unpacklo_epi16(alpha, alpha);
+
+        __m128i* p = reinterpret_cast<__m128i*>(pixels + x * 4);
+        const __m128i dst = _mm_loadu_si128(p);
+        const __m128i lo = blend(_mm_unpacklo_epi8(dst, zero), _mm_unpacklo_epi8(alpha, zero));
+        const __m128i hi = blend(_mm_unpackhi_epi8(dst, zero), _mm_unpackhi_epi8(alpha, zero));
+        _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+    }
+    blendSpan(pixels, coverage, x, width, color);
+}
+
+#elif defined(THEMERASTER_NEON)
+
+void gradientRowImpl(std::uint8_t* out, unsigned int width, const std::int32_t start[4], const std::int32_t step[4],
+                     unsigned int y) {
+    int32x4_t value[4];
+    int32x4_t dither[4];
+    for (int i = 0; i < 4; ++i) {
+        const std::int32_t lanes[4] = {start[0] + i * step[0], start[1] + i * step[1], start[2] + i * step[2],
+                                       start[3] + i * step[3]};
+        value[i] = vld1q_s32(lanes);
+        dither[i] = vdupq_n_s32(ditherAt(i, y));
+    }
+    const std::int32_t advanceLanes[4] = {step[0] * 4, step[1] * 4, step[2] * 4, step[3] * 4};
+    const int32x4_t advance = vld1q_s32(advanceLanes);
+
+    unsigned int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        int16x4_t level[4];
+        for (int i = 0; i < 4; ++i) {
+            level[i] = vqmovn_s32(vshrq_n_s32(vaddq_s32(value[i], dither[i]), 16));
+            value[i] = vaddq_s32(value[i], advance);
+        }
+        vst1_u8(out + x * 4, vqmovun_s16(vcombine_s16(level[0], level[1])));
+        vst1_u8(out + x * 4 + 8, vqmovun_s16(vcombine_s16(level[2], level[3])));
+    }
+    gradientSpan(out, x, width, start, step, y);
+}
+
+// 8 pixels per iteration; vld4 splits the channels so each is one multiply-accumulate
+void blendRowImpl(std::uint8_t* pixels, const std::uint8_t* coverage, unsigned int width, const std::uint8_t color[4]) {
+    unsigned int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        uint8x8x4_t px = vld4_u8(pixels + x * 4);
+        const uint8x8_t alpha = vld1_u8(coverage + x);
+        const uint8x8_t inverse = vmvn_u8(alpha);
+        for (int c = 0; c < 4; ++c) {
+            uint16x8_t t = vmlal_u8(vmull_u8(px.val[c], inverse), vdup_n_u8(color[c]), alpha);
+            t = vaddq_u16(t, vdupq_n_u16(128));
+            px.val[c] = vshrn_n_u16(vaddq_u16(t, vshrq_n_u16(t, 8)), 8);
+        }
+        vst4_u8(pixels + x * 4, px);
+    }
+    blendSpan(pixels, coverage, x, width, color);
+}
+
+#else
+
+void gradientRowImpl(std::uint8_t* out, unsigned int width, const std::int32_t start[4], const std::int32_t step[4],
+                     unsigned int y) {
+    gradientSpan(out, 0, width, start, step, y);
+}
+
+void blendRowImpl(std::uint8_t* pixels, const std::uint8_t* coverage, unsigned int width, const std::uint8_t color[4]) {
+    blendSpan(pixels, coverage, 0, width, color);
+}
+
+#endif
+
+// `color` composited over the opaque `base`
+sf::Color over(sf::Color color, sf::Color base) {
+    auto mix = [&](std::uint8_t c, std::uint8_t b) {
+        return static_cast<std::uint8_t>((c * color.a + b * (255 - color.a) + 127) / 255);
+    };
+    return sf::Color(mix(color.r, base.r), mix(color.g, base.g), mix(color.b, base.b), 255);
+}
+
+// Distance from u to the nearest multiple of `period`
+float distanceToLine(float u, float period) {
+    const float m = u - period * std::floor(u / period);
+    return std::min(m, period - m);
+}
+
+// Antialiased coverage (0-1) of a line or disc edge `halfWidth` from its centre, one pixel soft
+float edgeCoverage(float distance, float halfWidth) {
+    return std::clamp(halfWidth + 0.5f - distance, 0.f, 1.f);
+}
+
+// Fills one row's coverage (0-1) for the pattern; the per-column terms are precomputed once per image
+class PatternCoverage {
+public:
+    PatternCoverage(const PatternSettings& pattern, unsigned int width, unsigned int height)
+        : type_(pattern.type) {
+        const float scale = std::max(pattern.scale, 0.25f);
+        const float intensity = std::clamp(pattern.intensity, 0.f, 1.f);
+        if (type_ == "dots") {
+            cell_ = 24.f * scale;
+            halfWidth_ = cell_ * (0.08f + 0.3f * intensity);
+            columns_.resize(width);
+            for (unsigned int x = 0; x < width; ++x) {
+                const float dx = distanceToLine(x + 0.5f - cell_ * 0.5f, cell_);
+                columns_[x] = dx * dx;
+            }
+        } else if (type_ == "grid" || type_ == "waves") {
+            cell_ = 32.f * scale;
+            halfWidth_ = std::max(0.5f, cell_ * 0.12f * intensity);
+            columns_.resize(width);
+            for (unsigned int x = 0; x < width; ++x) {
+                // Grid: coverage of the vertical line; waves: the curve's vertical offset
+                columns_[x] = type_ == "grid" ? edgeCoverage(distanceToLine(x + 0.5f, cell_), halfWidth_)
+                                              : cell_ * 0.25f * std::sin(2.f * PI * (x + 0.5f) / (cell_ * 4.f));
+            }
+        } else if (type_ == "diagonal") {
+            // Stripes depend only on x + y; the line is 45 degrees, so distances shrink by sqrt(2)
+            cell_ = 24.f * scale;
+            halfWidth_ = std::max(0.5f, cell_ * 0.25f * intensity);
+            columns_.resize(static_cast<std::size_t>(width) + height);
+            for (std::size_t i = 0; i < columns_.size(); ++i) {
+                columns_[i] = edgeCoverage(distanceToLine((i + 1.f) * 0.70710678f, cell_), halfWidth_);
+            }
+        } else if (type_ == "checkerboard") {
+            cell_ = 32.f * scale;
+        }
+    }
+
+    void row(unsigned int y, unsigned int width, float* out) const {
+        const float py = y + 0.5f;
+        if (type_ == "dots") {
+            const float dy = distanceToLine(py - cell_ * 0.5f, cell_);
+            for (unsigned int x = 0; x < width; ++x) out[x] = edgeCoverage(std::sqrt(columns_[x] + dy * dy), halfWidth_);
+        } else if (type_ == "grid") {
+            const float horizontal = edgeCoverage(distanceToLine(py, cell_), halfWidth_);
+            for (unsigned int x = 0; x < width; ++x) out[x] = std::max(columns_[x], horizontal);
+        } else if (type_ == "waves") {
+            for (unsigned int x = 0; x < width; ++x) out[x] = edgeCoverage(distanceToLine(py + columns_[x], cell_), halfWidth_);
+        } else if (type_ == "diagonal") {
+            std::copy(columns_.begin() + y, columns_.begin() + y + width, out);
+        } else if (type_ == "checkerboard") {
+            const unsigned int cellY = static_cast<unsigned int>(py / cell_);
+            for (unsigned int x = 0; x < width; ++x) {
+                out[x] = ((static_cast<unsigned int>((x + 0.5f) / cell_) + cellY) & 1) ? 1.f : 0.f;
+            }
+        } else {
+            std::fill(out, out + width, 0.f);
+        }
+    }
+
+private:
+    std::string type_;
+    float cell_ = 1.f;
+    float halfWidth_ = 0.f;
+    std::vector<float> columns_;
+};
+
+} // namespace
+
+void gradientRow(std::uint8_t* out, unsigned int width, const std::int32_t start[4], const std::int32_t step[4],
+                 unsigned int y) {
+    gradientRowImpl(out, width, start, step, y);
+}
+
+void blendRow(std::uint8_t* pixels, const std::uint8_t* coverage, unsigned int width, const std::uint8_t color[4]) {
+    blendRowImpl(pixels, coverage, width, color);
+}
+
+sf::Image render(const CustomTheme& theme, sf::Vector2u size) {
+    const unsigned int width = size.x;
+    const unsigned int height = size.y;
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * height * 4);
+    if (pixels.empty()) return sf::Image();
+
+    // The gradient's ends are composited over the primary colour, so the result is opaque
+    const sf::Color base(theme.colors.primary.r, theme.colors.primary.g, theme.colors.primary.b, 255);
+    const GradientSettings& gradient = theme.gradient;
+    const sf::Color from = gradient.enabled ? over(gradient.startColor, base) : base;
+    const sf::Color to = gradient.enabled ? over(gradient.endColor, base) : base;
+
+    // t runs 0-1 along the angle's direction (90 degrees: top to bottom) across the whole image
+    const float radians = gradient.angle * PI / 180.f;
+    const float dirX = std::cos(radians);
+    const float dirY = std::sin(radians);
+    const float extent = std::max(1.f, width * std::abs(dirX) + height * std::abs(dirY));
+    const float fromChannels[4] = {float(from.r), float(from.g), float(from.b), 255.f};
+    const float deltas[4] = {float(to.r) - from.r, float(to.g) - from.g, float(to.b) - from.b, 0.f};
+    std::int32_t step[4];
+    for (int c = 0; c < 4; ++c) step[c] = static_cast<std::int32_t>(std::lround(deltas[c] * dirX / extent * 65536.f));
+
+    for (unsigned int y = 0; y < height; ++y) {
+        const float t0 = 0.5f + ((0.5f - width * 0.5f) * dirX + (y + 0.5f - height * 0.5f) * dirY) / extent;
+        std::int32_t start[4];
+        for (int c = 0; c < 4; ++c) {
+            start[c] = static_cast<std::int32_t>(std::lround((fromChannels[c] + deltas[c] * t0) * 65536.f));
+        }
+        gradientRow(pixels.data() + static_cast<std::size_t>(y) * width * 4, width, start, step, y);
+    }
+
+    const PatternSettings& pattern = theme.pattern;
+    if (pattern.type != "none" && pattern.color.a > 0) {
+        const PatternCoverage shape(pattern, width, height);
+        const std::uint8_t color[4] = {pattern.color.r, pattern.color.g, pattern.color.b, 255};
+        std::vector<float> rowCoverage(width);
+        std::vector<std::uint8_t> coverage(width);
+        for (unsigned int y = 0; y < height; ++y) {
+            shape.row(y, width, rowCoverage.data());
+            for (unsigned int x = 0; x < width; ++x) {
+                coverage[x] = static_cast<std::uint8_t>(rowCoverage[x] * pattern.color.a + 0.5f);
+            }
+            blendRow(pixels.data() + static_cast<std::size_t>(y) * width * 4, coverage.data(), width, color);
+        }
+    }
+
+    return sf::Image(size, pixels.data());
+}
+
+bool sameBackground(const CustomTheme& a, const CustomTheme& b) {
+    if (a.colors.primary != b.colors.primary || a.gradient.enabled != b.gradient.enabled ||
+        a.pattern.type != b.pattern.type) {
+        return false;
+    }
+    if (a.gradient.enabled && (a.gradient.startColor != b.gradient.startColor ||
+                               a.gradient.endColor != b.gradient.endColor || a.gradient.angle != b.gradient.angle)) {
+        return false;
+    }
+    if (a.pattern.type != "none" && (a.pattern.color != b.pattern.color || a.pattern.intensity != b.pattern.intensity ||
+                                      a.pattern.scale != b.pattern.scale)) {
+        return false;
+    }
+    return true;
+}
+
+const char* kernelName() {
+#if defined(THEMERASTER_SSE2)
+    return "SSE2";
+#elif defined(THEMERASTER_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace themeraster
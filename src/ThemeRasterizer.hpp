@@ -0,0 +1,35 @@
+#pragma once
+#include "CustomThemeCreator.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+/**
+ * CPU rendering of a custom theme's background: the primary colour or the
+ * gradient at any angle, with 4x4 ordered dithering so slow ramps don't
+ * band, then the pattern blended over it. Rows are filled and blended with
+ * SSE2 on x86-64 and NEON on ARM64, with a bit-identical scalar fallback.
+ * Callers render once per settings change and keep the texture.
+ *
+ * Pattern intensity sets how much of each cell the shape covers (dot
+ * radius, line width); the pattern colour's alpha sets its opacity.
+ */
+namespace themeraster {
+
+// Renders `theme`'s background at `size`, opaque
+sf::Image render(const CustomTheme& theme, sf::Vector2u size);
+
+// True if both themes render the same background; settings that aren't drawn are ignored
+bool sameBackground(const CustomTheme& a, const CustomTheme& b);
+
+// One gradient row of RGBA. Channel c at pixel x is (start[c] + x * step[c]) in 16.16 fixed point,
+// dithered with row `y` of the Bayer matrix and clamped to 0-255
+void gradientRow(std::uint8_t* out, unsigned int width, const std::int32_t start[4], const std::int32_t step[4],
+                 unsigned int y);
+
+// Blends `color` over each pixel of an RGBA row by its coverage (0-255), rounded exactly
+void blendRow(std::uint8_t* pixels, const std::uint8_t* coverage, unsigned int width, const std::uint8_t color[4]);
+
+// Name of the kernels gradientRow() and blendRow() use, for logs
+const char* kernelName();
+
+} // namespace themeraster
@@ -1,9 +1,41 @@
 #include "ThemeSelector.hpp"
+#include "ThemeBundle.hpp"
 #include "UiSoundBank.hpp"
 #include "UserProfile.hpp"
 #include <windows.h>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <cctype>
+#include <filesystem>
+
+namespace {
+
+const std::string BACKGROUNDS_DIR = "assets/Backgrounds";
+const std::string THEMES_DIR = "assets/Themes";
+
+// Loose images from the backgrounds folder; PSP themes and saved custom themes from the themes folder
+bool isThemeFile(const std::string& directory, const std::string& filename) {
+    std::string ext = filename.substr(filename.find_last_of('.') + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (directory == THEMES_DIR) return ext == "ptf" || ext == "ctheme";
+    return ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "bmp";
+}
+
+bool isBundleFile(const std::string& filename) {
+    std::string ext = std::filesystem::path(filename).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ThemeBundle::EXTENSION;
+}
+
+// Case-insensitive, like an NTFS listing, so patched and re-listed catalogs agree on the order
+bool filenameLess(const std::string& a, const std::string& b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char x, unsigned char y) {
+        return std::tolower(x) < std::tolower(y);
+    });
+}
+
+} // namespace
 
 ThemeSelector::ThemeSelector(UiSoundBank& sounds, UserProfile& profile)
     : soundBank_(sounds)
@@ -36,6 +68,8 @@ ThemeSelector::ThemeSelector(UiSoundBank& sounds, UserProfile& profile)
         fontLoaded_ = true;
     }
     
+    backgroundWatcher_.start();
+    themeWatcher_.start();
     loadBackgrounds();
 }
 
@@ -49,58 +83,182 @@ void ThemeSelector::reset() {
     parallaxOffsetY_ = 0.f;
     targetParallaxX_ = 0.f;
     targetParallaxY_ = 0.f;
-    loadBackgrounds();
+    navInput_.reset();
+    refreshBackgrounds();
+    requestPreview();
+}
+
+void ThemeSelector::releaseTextures() {
+    themes_.clear();
+    previewCache_.clear();
+    catalogLoaded_ = false;
+}
+
+void ThemeSelector::requestPreview() {
+    // Only the selected theme is fetched; a decode still queued for one scrolled past is dropped
+    if (themes_.empty()) return;
+    ThemeEntry& theme = themes_[selectedIndex_];
+    // A .ptf's wallpaper is only extracted once the theme is selected
+    if (theme.previewPath.empty() && theme.ptf) theme.previewPath = theme.ptf->wallpaperPath();
+    if (!theme.previewPath.empty()) previewCache_.setResidencyWindow({theme.previewPath});
+}
+
+void ThemeSelector::refreshBackgrounds() {
+    // With the folders watched, only the files they reported are looked at again
+    if (!catalogLoaded_ || !backgroundWatcher_.isWatching() || !themeWatcher_.isWatching()) {
+        loadBackgrounds();
+        return;
+    }
+    const DirectoryWatcher::Changes backgrounds = backgroundWatcher_.takeChanges();
+    const DirectoryWatcher::Changes themes = themeWatcher_.takeChanges();
+    if (!backgrounds.rescan && !themes.rescan && backgrounds.files.empty() && themes.files.empty()) return;
+
+    // A full-size preview may be of a file that just changed
+    previewCache_.clear();
+    if (backgrounds.rescan || themes.rescan) {
+        loadBackgrounds();
+        return;
+    }
+    applyBackgroundChanges(BACKGROUNDS_DIR, backgrounds.files);
+    applyBackgroundChanges(THEMES_DIR, themes.files);
+    std::cout << "Themes updated: " << backgrounds.files.size() + themes.files.size() << " file(s) changed, "
+              << themes_.size() << " total\n";
+    rebuildSprites();
 }
 
 void ThemeSelector::loadBackgrounds() {
     std::cout << "\n=== LOADING THEMES ==="<< std::endl;
+    // The listing below covers anything reported so far
+    backgroundWatcher_.takeChanges();
+    themeWatcher_.takeChanges();
+
+    // Themes already in memory and unchanged on disk are kept as they are
+    std::vector<ThemeEntry> previous = std::move(themes_);
     themes_.clear();
     
-    std::string searchPath = "assets/Backgrounds/*.*";
-    WIN32_FIND_DATAA findData;
-    HANDLE hFind = FindFirstFileA(searchPath.c_str(), &findData);
-    
-    if (hFind != INVALID_HANDLE_VALUE) {
+    for (const std::string& directory : {BACKGROUNDS_DIR, THEMES_DIR}) {
+        std::string searchPath = directory + "/*.*";
+        WIN32_FIND_DATAA findData;
+        HANDLE hFind = FindFirstFileA(searchPath.c_str(), &findData);
+        if (hFind == INVALID_HANDLE_VALUE) continue;
+        
         do {
-            if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
-                std::string filename = findData.cFileName;
-                std::string ext = filename.substr(filename.find_last_of('.') + 1);
-                std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                
-                if (ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "bmp") {
-                    ThemeEntry entry;
-                    entry.filename = filename;
-                    entry.fullPath = "assets/Backgrounds/" + filename;
-                    
-                    // Create display name (remove extension)
-                    size_t dotPos = filename.find_last_of('.');
-                    entry.displayName = (dotPos != std::string::npos) ? filename.substr(0, dotPos) : filename;
-                    
-                    // Load texture ONCE - it stays in memory as part of ThemeEntry
-                    if (entry.texture.loadFromFile(entry.fullPath)) {
-                        std::cout << "  [" << themes_.size() << "] Loaded texture: " << entry.displayName
-                                  << " from " << entry.fullPath
-                                  << " | Size: " << entry.texture.getSize().x << "x" << entry.texture.getSize().y
-                                  << std::endl;
-                        
-                        // Add to vector FIRST (don't create sprite yet - texture will move!)
-                        themes_.push_back(std::move(entry));
-                    } else {
-                        std::cerr << "  ERROR: Failed to load texture from " << entry.fullPath << std::endl;
-                    }
+            if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && isThemeFile(directory, findData.cFileName)) {
+                ThemeEntry entry = makeEntry(directory, findData.cFileName);
+                auto kept = std::find_if(previous.begin(), previous.end(), [&](const ThemeEntry& old) {
+                    return old.fullPath == entry.fullPath && old.mtime == entry.mtime && old.thumbnail;
+                });
+                if (kept != previous.end()) {
+                    // Add to vector FIRST (don't create sprite yet - texture will move!)
+                    themes_.push_back(std::move(*kept));
+                } else if (loadThumbnail(entry)) {
+                    themes_.push_back(std::move(entry));
                 }
             }
         } while (FindNextFileA(hFind, &findData));
         FindClose(hFind);
     }
     
+    std::sort(themes_.begin(), themes_.end(), [](const ThemeEntry& a, const ThemeEntry& b) {
+        return filenameLess(a.filename, b.filename);
+    });
+    catalogLoaded_ = true;
     std::cout << "Total themes loaded: " << themes_.size() << "\n";
+    rebuildSprites();
+}
+
+void ThemeSelector::applyBackgroundChanges(const std::string& directory, const std::vector<std::string>& files) {
+    for (const std::string& filename : files) {
+        const std::string fullPath = directory + "/" + filename;
+        auto existing = std::find_if(themes_.begin(), themes_.end(), [&](const ThemeEntry& theme) {
+            return theme.fullPath == fullPath;
+        });
+
+        std::error_code ec;
+        if (!isThemeFile(directory, filename) || !std::filesystem::is_regular_file(fullPath, ec)) {
+            // Removed or renamed away
+            if (existing != themes_.end()) {
+                std::cout << "  Theme removed: " << filename << std::endl;
+                themes_.erase(existing);
+            }
+            continue;
+        }
+
+        ThemeEntry entry = makeEntry(directory, filename);
+        if (existing != themes_.end() && existing->mtime == entry.mtime) continue;
+        if (!loadThumbnail(entry)) continue;
+        if (existing != themes_.end()) {
+            *existing = std::move(entry);
+        } else {
+            auto position = std::lower_bound(themes_.begin(), themes_.end(), entry, [](const ThemeEntry& a, const ThemeEntry& b) {
+                return filenameLess(a.filename, b.filename);
+            });
+            themes_.insert(position, std::move(entry));
+        }
+    }
+}
+
+ThemeSelector::ThemeEntry ThemeSelector::makeEntry(const std::string& directory, const std::string& filename) {
+    ThemeEntry entry;
+    entry.filename = filename;
+    entry.fullPath = directory + "/" + filename;
+    if (directory != THEMES_DIR) entry.previewPath = entry.fullPath;
+    
+    // Create display name (remove extension)
+    size_t dotPos = filename.find_last_of('.');
+    entry.displayName = (dotPos != std::string::npos) ? filename.substr(0, dotPos) : filename;
+    
+    std::error_code ec;
+    entry.mtime = static_cast<std::int64_t>(
+        std::filesystem::last_write_time(entry.fullPath, ec).time_since_epoch().count());
+    return entry;
+}
+
+bool ThemeSelector::loadThumbnail(ThemeEntry& entry) {
+    // A saved custom theme is previewed by its rendered background, scaled down once like a wallpaper
+    const bool bundle = isBundleFile(entry.filename);
+    ThumbnailCache::Decoder decode;
+    if (bundle) {
+        decode = [](const std::string& path) -> std::optional<sf::Image> {
+            ThemeBundle themeBundle;
+            if (!themeBundle.load(path)) return std::nullopt;
+            return sf::Image(themeBundle.backgroundSize(), themeBundle.backgroundPixels());
+        };
+    }
+
+    // A .ptf carries its own small preview; only its header and that section are read here
+    if (entry.previewPath.empty() && !bundle) {
+        entry.ptf = std::make_unique<PtfTheme>();
+        if (entry.ptf->open(entry.fullPath)) {
+            const std::string preview = entry.ptf->previewPath();
+            if (!preview.empty() && entry.texture.loadFromFile(preview)) {
+                entry.texture.setSmooth(true);
+                if (!entry.ptf->title().empty()) entry.displayName = entry.ptf->title();
+                std::cout << "  Loaded theme preview: " << entry.displayName << std::endl;
+                return true;
+            }
+        }
+        std::cerr << "  ERROR: Failed to load theme " << entry.fullPath << std::endl;
+        return false;
+    }
+
+    // Load the thumbnail ONCE - only the downscaled copy stays in memory
+    std::optional<sf::Image> thumbnail = thumbnails_.load(entry.fullPath, decode);
+    if (!thumbnail || !entry.texture.loadFromImage(*thumbnail)) {
+        std::cerr << "  ERROR: Failed to load thumbnail for " << entry.fullPath << std::endl;
+        return false;
+    }
+    entry.texture.setSmooth(true);
+    std::cout << "  Loaded thumbnail: " << entry.displayName
+              << " | Size: " << entry.texture.getSize().x << "x" << entry.texture.getSize().y << std::endl;
+    return true;
+}
+
+void ThemeSelector::rebuildSprites() {
+    if (selectedIndex_ >= themes_.size()) selectedIndex_ = 0;
     
     // NOW create sprites after all textures are in their final memory locations
-    std::cout << "=== CREATING SPRITES WITH STABLE TEXTURE ADDRESSES ===" << std::endl;
-    for (size_t i = 0; i < themes_.size(); ++i) {
-        auto& theme = themes_[i];
-        
+    for (auto& theme : themes_) {
         // Create sprite using the now-stable texture reference
         theme.thumbnail = std::make_unique<sf::Sprite>(theme.texture);
         
@@ -109,13 +267,7 @@ void ThemeSelector::loadBackgrounds() {
         float scaleY = THUMBNAIL_HEIGHT / theme.texture.getSize().y;
         float scale = std::min(scaleX, scaleY);
         theme.thumbnail->setScale({scale, scale});
-        
-        std::cout << "  [" << i << "] Created sprite: " << theme.displayName 
-                  << " | Texture @ " << &theme.texture
-                  << " | Sprite @ " << theme.thumbnail.get()
-                  << std::endl;
     }
-    std::cout << std::endl;
     
     updateLayout();
 }
@@ -132,48 +284,16 @@ void ThemeSelector::updateLayout() {
 void ThemeSelector::handleEvent(const sf::Event& event) {
     if (finished_) return;
     
+    if (const auto action = navInput_.handleEvent(event)) {
+        if (*action == NavAction::Left) {
+            moveSelection(-1);
+        } else if (*action == NavAction::Right) {
+            moveSelection(1);
+        }
+    }
+    
     if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-        if (keyPressed->code == sf::Keyboard::Key::Left) {
-            if (!themes_.empty()) {
-                // Wrap around to end if at beginning
-                if (selectedIndex_ == 0) {
-                    selectedIndex_ = themes_.size() - 1;
-                } else {
-                    selectedIndex_--;
-                }
-                // Restart animations for new selection
-                selectedScale_ = 1.0f;
-                previewAlpha_ = 0.0f;
-                targetPreviewAlpha_ = 100.0f;
-                targetParallaxX_ += 8.f;
-                soundBank_.playCursor();
-                // Update camera to center selected item
-                const float thumbWidth = THUMBNAIL_WIDTH;
-                const float spacing = 30.f;
-                targetCameraOffsetX_ = -selectedIndex_ * (thumbWidth + spacing);
-                updateLayout();
-            }
-        } else if (keyPressed->code == sf::Keyboard::Key::Right) {
-            if (!themes_.empty()) {
-                // Wrap around to beginning if at end
-                if (selectedIndex_ >= themes_.size() - 1) {
-                    selectedIndex_ = 0;
-                } else {
-                    selectedIndex_++;
-                }
-                // Restart animations for new selection
-                selectedScale_ = 1.0f;
-                previewAlpha_ = 0.0f;
-                targetPreviewAlpha_ = 100.0f;
-                targetParallaxX_ -= 8.f;
-                soundBank_.playCursor();
-                // Update camera to center selected item
-                const float thumbWidth = THUMBNAIL_WIDTH;
-                const float spacing = 30.f;
-                targetCameraOffsetX_ = -selectedIndex_ * (thumbWidth + spacing);
-                updateLayout();
-            }
-        } else if (keyPressed->code == sf::Keyboard::Key::Enter || keyPressed->code == sf::Keyboard::Key::Space) {
+        if (keyPressed->code == sf::Keyboard::Key::Enter || keyPressed->code == sf::Keyboard::Key::Space) {
             if (!themes_.empty()) {
                 selectedBackground_ = themes_[selectedIndex_].filename;
                 finished_ = true;
@@ -184,50 +304,6 @@ void ThemeSelector::handleEvent(const sf::Event& event) {
             finished_ = true;
             soundBank_.playCancel();
         }
-    } else if (const auto* joystickMoved = event.getIf<sf::Event::JoystickMoved>()) {
-        const float deadzone = 50.0f;
-        
-        if (joystickMoved->axis == sf::Joystick::Axis::X || joystickMoved->axis == sf::Joystick::Axis::PovX) {
-            if (joystickMoved->position < -deadzone) {
-                // Left - wrap around
-                if (!themes_.empty()) {
-                    if (selectedIndex_ == 0) {
-                        selectedIndex_ = themes_.size() - 1;
-                    } else {
-                        selectedIndex_--;
-                    }
-                    // Restart animations for new selection
-                    selectedScale_ = 1.0f;
-                    previewAlpha_ = 0.0f;
-                    targetPreviewAlpha_ = 100.0f;
-                    targetParallaxX_ += 8.f;
-                    soundBank_.playCursor();
-                    const float thumbWidth = THUMBNAIL_WIDTH;
-                    const float spacing = 30.f;
-                    targetCameraOffsetX_ = -selectedIndex_ * (thumbWidth + spacing);
-                    updateLayout();
-                }
-            } else if (joystickMoved->position > deadzone) {
-                // Right - wrap around
-                if (!themes_.empty()) {
-                    if (selectedIndex_ >= themes_.size() - 1) {
-                        selectedIndex_ = 0;
-                    } else {
-                        selectedIndex_++;
-                    }
-                    // Restart animations for new selection
-                    selectedScale_ = 1.0f;
-                    previewAlpha_ = 0.0f;
-                    targetPreviewAlpha_ = 100.0f;
-                    targetParallaxX_ -= 8.f;
-                    soundBank_.playCursor();
-                    const float thumbWidth = THUMBNAIL_WIDTH;
-                    const float spacing = 30.f;
-                    targetCameraOffsetX_ = -selectedIndex_ * (thumbWidth + spacing);
-                    updateLayout();
-                }
-            }
-        }
     } else if (const auto* joystickPressed = event.getIf<sf::Event::JoystickButtonPressed>()) {
         if (joystickPressed->button == 0) { // Cross/A button
             if (!themes_.empty()) {
@@ -243,7 +319,42 @@ void ThemeSelector::handleEvent(const sf::Event& event) {
     }
 }
 
+void ThemeSelector::moveSelection(int direction) {
+    if (themes_.empty()) return;
+    
+    // Wrap around at either end
+    if (direction < 0) {
+        selectedIndex_ = selectedIndex_ == 0 ? themes_.size() - 1 : selectedIndex_ - 1;
+    } else {
+        selectedIndex_ = selectedIndex_ >= themes_.size() - 1 ? 0 : selectedIndex_ + 1;
+    }
+    // Restart animations for new selection
+    selectedScale_ = 1.0f;
+    previewAlpha_ = 0.0f;
+    targetPreviewAlpha_ = 100.0f;
+    targetParallaxX_ += direction < 0 ? 8.f : -8.f;
+    soundBank_.playCursor();
+    // Update camera to center selected item
+    targetCameraOffsetX_ = -static_cast<float>(selectedIndex_) * (THUMBNAIL_WIDTH + THUMBNAIL_SPACING);
+    requestPreview();
+    updateLayout();
+}
+
 void ThemeSelector::update(float dt) {
+    if (!finished_) {
+        for (NavAction action : navInput_.update(dt)) {
+            if (action == NavAction::Left) {
+                moveSelection(-1);
+            } else if (action == NavAction::Right) {
+                moveSelection(1);
+            }
+        }
+    }
+    
+    // Upload the selected theme's full image once the worker has decoded it
+    previewCache_.update(1);
+    previewPending_ = previewCache_.hasPendingWork();
+
     // Smooth camera follow to center selected item
     const float cameraLerpSpeed = 6.0f;
     cameraOffsetX_ += (targetCameraOffsetX_ - cameraOffsetX_) * cameraLerpSpeed * dt;
@@ -270,17 +381,33 @@ void ThemeSelector::update(float dt) {
     parallaxOffsetY_ = std::max(-15.f, std::min(15.f, parallaxOffsetY_));
 }
 
+bool ThemeSelector::isAnimating() const {
+    // The lerps above only approach their targets, so stop redrawing once the remainder is invisible
+    return navInput_.isHolding() ||
+           previewPending_ ||
+           std::abs(targetCameraOffsetX_ - cameraOffsetX_) > 0.25f ||
+           std::abs(targetScale_ - selectedScale_) > 0.001f ||
+           std::abs(targetPreviewAlpha_ - previewAlpha_) > 0.5f ||
+           std::abs(targetParallaxX_ - parallaxOffsetX_) > 0.05f ||
+           std::abs(targetParallaxY_ - parallaxOffsetY_) > 0.05f ||
+           std::abs(targetParallaxX_) > 0.05f ||
+           std::abs(targetParallaxY_) > 0.05f;
+}
+
 void ThemeSelector::draw(sf::RenderWindow& window) {
     if (debugMode_) {
         std::cout << "\n=== THEME DRAW FRAME ===" << std::endl;
     }
     
-    // Preview selected background (full screen, dimmed)
+    // Preview selected background (full screen, dimmed); the thumbnail stands in until the full image is decoded
     if (!themes_.empty() && themes_[selectedIndex_].thumbnail) {
-        sf::Sprite previewSprite(themes_[selectedIndex_].texture);
+        const std::string& previewPath = themes_[selectedIndex_].previewPath;
+        const sf::Texture* fullTexture = previewPath.empty() ? nullptr : previewCache_.get(previewPath);
+        const sf::Texture& previewTexture = fullTexture ? *fullTexture : themes_[selectedIndex_].texture;
+        sf::Sprite previewSprite(previewTexture);
         
         // Scale to fill screen while maintaining aspect ratio
-        sf::Vector2u texSize = themes_[selectedIndex_].texture.getSize();
+        sf::Vector2u texSize = previewTexture.getSize();
         float scaleX = 1280.f / texSize.x;
         float scaleY = 720.f / texSize.y;
         float scale = std::max(scaleX, scaleY);
@@ -1,5 +1,10 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "DirectoryWatcher.hpp"
+#include "InputRepeater.hpp"
+#include "PtfTheme.hpp"
+#include "TextureCache.hpp"
+#include "ThumbnailCache.hpp"
 #include <string>
 #include <vector>
 #include <memory>
@@ -12,11 +17,13 @@ public:
     ThemeSelector(UiSoundBank& sounds, UserProfile& profile);
     
     void reset();
+    void releaseTextures(); // reset() loads them again, from the thumbnail cache
     void handleEvent(const sf::Event& event);
     void update(float dt);
     void draw(sf::RenderWindow& window);
     
     bool isFinished() const { return finished_; }
+    bool isAnimating() const; // True until the camera, scale, fade and parallax have settled
     bool wasCancelled() const { return cancelled_; }
     std::string getSelectedBackground() const { return selectedBackground_; }
     
@@ -24,13 +31,23 @@ private:
     struct ThemeEntry {
         std::string filename;      // e.g., "background1.png"
         std::string displayName;   // e.g., "background1"
-        std::string fullPath;      // e.g., "assets/Backgrounds/background1.png"
-        sf::Texture texture;       // Persistent texture - MUST live as long as sprite
+        std::string fullPath;      // e.g., "assets/Backgrounds/background1.png" or "assets/Themes/x.ptf"
+        std::string previewPath;   // Full-size image; for a .ptf its wallpaper, extracted when first selected
+        std::unique_ptr<PtfTheme> ptf; // Set for .ptf themes
+        std::int64_t mtime = 0;    // Of fullPath when the thumbnail was loaded
+        sf::Texture texture;       // Thumbnail, fits THUMBNAIL_MAX_* - MUST live as long as sprite
         std::unique_ptr<sf::Sprite> thumbnail;  // Persistent sprite using texture
     };
     
-    void loadBackgrounds();
+    void refreshBackgrounds();  // Applies watched changes, or re-lists the folder if they're unknown
+    void loadBackgrounds();     // Full listing; unchanged entries are kept
+    void applyBackgroundChanges(const std::string& directory, const std::vector<std::string>& files);
+    ThemeEntry makeEntry(const std::string& directory, const std::string& filename);
+    bool loadThumbnail(ThemeEntry& entry);
+    void rebuildSprites();      // After themes_ changed; textures may have moved
     void updateLayout();  // Update sprite positions based on scroll
+    void moveSelection(int direction); // -1 left, +1 right, wrapping
+    void requestPreview();             // Full-size image of the selected theme only
     
     UiSoundBank& soundBank_;
     UserProfile& userProfile_;
@@ -39,6 +56,15 @@ private:
     bool fontLoaded_;
     
     std::vector<ThemeEntry> themes_;  // All themes with persistent textures/sprites
+    DirectoryWatcher backgroundWatcher_{"assets/Backgrounds"};
+    DirectoryWatcher themeWatcher_{"assets/Themes"}; // .ptf themes
+    bool catalogLoaded_ = false;      // themes_ matches the folder as of the last listing
+
+    // Thumbnails come from a downscaled copy on disk; only the selected theme's full image is
+    // decoded, on the cache's worker, for the background preview
+    ThumbnailCache thumbnails_{"assets/Backgrounds/.thumbs", THUMBNAIL_MAX_WIDTH, THUMBNAIL_MAX_HEIGHT};
+    TextureCache previewCache_{PREVIEW_BUDGET_BYTES};
+    bool previewPending_ = false; // Full image still decoding; sampled in update()
     
     size_t selectedIndex_;
     float scrollOffset_;
@@ -63,10 +89,15 @@ private:
     bool cancelled_;
     bool debugMode_; // Enable debug logging
     
+    InputRepeater navInput_; // Holding left/right scrolls through the thumbnails
+    
     // Layout constants
     static constexpr float THUMBNAIL_WIDTH = 320.f;
     static constexpr float THUMBNAIL_HEIGHT = 180.f;
     static constexpr float THUMBNAIL_SPACING = 30.f;
     static constexpr float START_X = 100.f;
     static constexpr float START_Y = 150.f;
+    static constexpr unsigned int THUMBNAIL_MAX_WIDTH = 384;  // The selected thumbnail is drawn at 1.2x
+    static constexpr unsigned int THUMBNAIL_MAX_HEIGHT = 216;
+    static constexpr std::size_t PREVIEW_BUDGET_BYTES = 64u * 1024u * 1024u; // Two 4K wallpapers
 };
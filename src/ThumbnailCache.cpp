@@ -0,0 +1,128 @@
+#include "ThumbnailCache.hpp"
+#include "ImageDownscale.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char THUMB_MAGIC[8] = {'P', 'S', 'P', 'T', 'H', 'M', 'B', '\0'};
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+} // namespace
+
+ThumbnailCache::ThumbnailCache(std::string cacheDir, unsigned int maxWidth, unsigned int maxHeight)
+    : cacheDir_(std::move(cacheDir))
+    , maxWidth_(maxWidth)
+    , maxHeight_(maxHeight) {
+}
+
+std::optional<ThumbnailCache::Stamp> ThumbnailCache::stampOf(const std::string& sourcePath) {
+    std::error_code ec;
+    Stamp stamp;
+    stamp.size = fs::file_size(sourcePath, ec);
+    if (ec) return std::nullopt;
+    stamp.mtime = static_cast<std::int64_t>(fs::last_write_time(sourcePath, ec).time_since_epoch().count());
+    if (ec) return std::nullopt;
+    return stamp;
+}
+
+std::string ThumbnailCache::cachePathFor(const std::string& sourcePath) const {
+    // One file per source path; the bound is part of the name so a layout change starts fresh
+    std::uint64_t hash = 1469598103934665603ull;
+    for (unsigned char c : sourcePath) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    std::ostringstream name;
+    name << cacheDir_ << "/" << std::hex << hash << std::dec << "_" << maxWidth_ << "x" << maxHeight_ << ".thumb";
+    return name.str();
+}
+
+std::optional<sf::Image> ThumbnailCache::read(const std::string& cachePath, const Stamp& stamp) const {
+    std::ifstream in(cachePath, std::ios::binary);
+    if (!in) return std::nullopt;
+
+    char magic[sizeof(THUMB_MAGIC)];
+    std::uint32_t version = 0;
+    Stamp cached;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, THUMB_MAGIC, sizeof(magic)) != 0 ||
+        !readValue(in, version) || version != FORMAT_VERSION ||
+        !readValue(in, cached.size) || !readValue(in, cached.mtime) ||
+        !readValue(in, width) || !readValue(in, height)) {
+        return std::nullopt;
+    }
+    if (cached.size != stamp.size || cached.mtime != stamp.mtime) return std::nullopt;
+    if (width == 0 || height == 0 || width > maxWidth_ || height > maxHeight_) return std::nullopt;
+
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * height * 4);
+    if (!in.read(reinterpret_cast<char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()))) return std::nullopt;
+    return sf::Image({width, height}, pixels.data());
+}
+
+void ThumbnailCache::write(const std::string& cachePath, const Stamp& stamp, const sf::Image& image) const {
+    std::error_code ec;
+    fs::create_directories(cacheDir_, ec);
+
+    // Written aside and renamed, so an interrupted write never looks like a valid thumbnail
+    const std::string tempPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "ThumbnailCache: cannot write " << tempPath << "\n";
+            return;
+        }
+        const sf::Vector2u size = image.getSize();
+        out.write(THUMB_MAGIC, sizeof(THUMB_MAGIC));
+        writeValue(out, FORMAT_VERSION);
+        writeValue(out, stamp.size);
+        writeValue(out, stamp.mtime);
+        writeValue(out, static_cast<std::uint32_t>(size.x));
+        writeValue(out, static_cast<std::uint32_t>(size.y));
+        out.write(reinterpret_cast<const char*>(image.getPixelsPtr()), static_cast<std::streamsize>(size.x) * size.y * 4);
+        if (!out) ec = std::make_error_code(std::errc::io_error);
+    }
+    if (!ec) fs::rename(tempPath, cachePath, ec);
+    if (ec) fs::remove(tempPath, ec);
+}
+
+std::optional<sf::Image> ThumbnailCache::load(const std::string& sourcePath, const Decoder& decode) {
+    const auto stamp = stampOf(sourcePath);
+    if (!stamp) return std::nullopt;
+
+    const std::string cachePath = cachePathFor(sourcePath);
+    if (auto cached = read(cachePath, *stamp)) return cached;
+
+    // Missing or stale: decode the full image once and keep only the small copy
+    std::optional<sf::Image> decoded = decode ? decode(sourcePath) : std::nullopt;
+    sf::Image full;
+    if (decoded) {
+        full = std::move(*decoded);
+    } else if (decode || !full.loadFromFile(sourcePath)) {
+        std::cerr << "ThumbnailCache: failed to decode " << sourcePath << "\n";
+        return std::nullopt;
+    }
+    const sf::Vector2u size = full.getSize();
+    downscale::RgbaImage scaled = downscale::toFit(full.getPixelsPtr(), size.x, size.y, maxWidth_, maxHeight_);
+    sf::Image thumbnail({scaled.width, scaled.height}, scaled.pixels.data());
+    write(cachePath, *stamp, thumbnail);
+    std::cout << "ThumbnailCache: " << sourcePath << " " << size.x << "x" << size.y << " -> "
+              << scaled.width << "x" << scaled.height << " (" << downscale::kernelName() << ")\n";
+    return thumbnail;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+/**
+ * Downscaled copies of large images kept on disk, so a folder of 4K
+ * wallpapers is only decoded in full once. Each thumbnail is raw RGBA
+ * stamped with its source's size and mtime; a changed source is decoded
+ * and scaled again (see ImageDownscale) on the next load.
+ */
+class ThumbnailCache {
+public:
+    ThumbnailCache(std::string cacheDir, unsigned int maxWidth, unsigned int maxHeight);
+
+    // Full-size decode of a source that sf::Image can't open itself
+    using Decoder = std::function<std::optional<sf::Image>(const std::string& sourcePath)>;
+
+    // The thumbnail of `sourcePath`, read from the cache if it is current, otherwise made and saved now
+    std::optional<sf::Image> load(const std::string& sourcePath, const Decoder& decode = nullptr);
+
+private:
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+    struct Stamp {
+        std::uint64_t size = 0;
+        std::int64_t mtime = 0;
+    };
+
+    static std::optional<Stamp> stampOf(const std::string& sourcePath);
+    std::string cachePathFor(const std::string& sourcePath) const;
+    std::optional<sf::Image> read(const std::string& cachePath, const Stamp& stamp) const;
+    void write(const std::string& cachePath, const Stamp& stamp, const sf::Image& image) const;
+
+    std::string cacheDir_;
+    unsigned int maxWidth_;
+    unsigned int maxHeight_;
+};
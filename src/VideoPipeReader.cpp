@@ -0,0 +1,246 @@
+#include "VideoPipeReader.hpp"
+#include "YuvConvert.hpp"
+#include <cmath>
+#include <iostream>
+
+#ifdef _WIN32
+    #define POPEN _popen
+    #define PCLOSE _pclose
+    #define POPEN_READ "rb" // Binary, or CR/LF translation corrupts the frames
+#else
+    #define POPEN popen
+    #define PCLOSE pclose
+    #define POPEN_READ "r"  // glibc rejects "rb"
+#endif
+
+VideoPipeReader::~VideoPipeReader() {
+    // A recording still being drained is worth finishing before exit; anything else is let go
+    bool draining = false;
+    if (stream_) {
+        std::lock_guard<std::mutex> lock(stream_->mutex);
+        draining = stream_->draining;
+    }
+    if (draining && thread_.joinable()) {
+        thread_.join();
+        return;
+    }
+    release();
+}
+
+bool VideoPipeReader::open(const std::string& command, unsigned int width, unsigned int height, float fps,
+                           PixelFormat format, const std::string& recordPath, const std::string& sourcePath) {
+    release();
+    auto stream = std::make_shared<Stream>();
+    stream->pipe = POPEN(command.c_str(), POPEN_READ);
+    if (!stream->pipe) {
+        std::cerr << "VideoPipeReader: Failed to open ffmpeg pipe.\n";
+        return false;
+    }
+
+    stream->format = format;
+    const bool yuv = format == PixelFormat::Yuv420;
+    stream->recordPath = yuv ? recordPath : std::string();
+    stream->sourcePath = sourcePath;
+    const std::size_t pixels = static_cast<std::size_t>(width) * height;
+    startThread(std::move(stream), width, height, fps, yuv ? pixels * 3 / 2 : pixels * 4);
+    return true;
+}
+
+bool VideoPipeReader::openCache(const std::string& cachePath, unsigned int width, unsigned int height) {
+    release();
+    auto stream = std::make_shared<Stream>();
+    if (!stream->cache.open(cachePath)) return false;
+    // The ring and the caller's texture are sized for the expected frame; a cache from another size would overrun them
+    if (stream->cache.width() != width || stream->cache.height() != height) {
+        std::cerr << "VideoPipeReader: " << cachePath << " holds " << stream->cache.width() << "x"
+                  << stream->cache.height() << " frames, expected " << width << "x" << height << "\n";
+        return false;
+    }
+
+    stream->format = PixelFormat::Yuv420;
+    const float fps = stream->cache.fps();
+    startThread(std::move(stream), width, height, fps, static_cast<std::size_t>(width) * height * 3 / 2);
+    return true;
+}
+
+void VideoPipeReader::startThread(std::shared_ptr<Stream> stream, unsigned int width, unsigned int height, float fps,
+                                  std::size_t frameBytes) {
+    stream->width = width;
+    stream->height = height;
+    stream->frameBytes = frameBytes;
+    stream->yuvFrame.resize(stream->format == PixelFormat::Yuv420 ? frameBytes : 0);
+    stream->fps = fps;
+    if (perf::enabled()) {
+        const bool yuv = stream->format == PixelFormat::Yuv420;
+        const std::string source = !stream->pipe ? "cache" : yuv ? "yuv420p pipe" : "rgba pipe";
+        stream->readSampler.emplace("Video frame read (" + source + ")", "ms");
+        if (yuv) stream->convertSampler.emplace("Video frame yuv420p->RGBA (" + std::string(yuv::kernelName()) + ")", "ms");
+    }
+    for (std::size_t i = 0; i < RING_FRAMES; ++i) {
+        stream->slots[i].resize(static_cast<std::size_t>(width) * height * 4);
+        stream->freeSlots.push_back(i);
+    }
+
+    stream_ = std::move(stream);
+    active_ = true;
+    thread_ = std::thread([stream = stream_] { stream->run(); });
+}
+
+void VideoPipeReader::close() {
+    if (!active_) return;
+    active_ = false;
+    bool drain = false;
+    {
+        std::lock_guard<std::mutex> lock(stream_->mutex);
+        // ffmpeg decodes far faster than real time; let an unfinished recording run to the end
+        drain = !stream_->recordPath.empty() && !stream_->endOfStream;
+        stream_->draining = drain;
+    }
+    if (drain) {
+        stream_->slotFreed.notify_all();
+    } else {
+        release();
+    }
+}
+
+void VideoPipeReader::release() {
+    active_ = false;
+    if (stream_) {
+        {
+            std::lock_guard<std::mutex> lock(stream_->mutex);
+            if (!stream_->draining) stream_->stop = true;
+        }
+        stream_->slotFreed.notify_all();
+        stream_.reset();
+    }
+    // A thread blocked in fread (ffmpeg still starting) returns once ffmpeg writes; pclose then
+    // closes our end, so ffmpeg's next write fails and it exits. Nobody waits for either.
+    if (thread_.joinable()) thread_.detach();
+}
+
+bool VideoPipeReader::Stream::readFrame(std::uint8_t* rgba) {
+    sf::Clock timer;
+    if (!pipe) {
+        if (!cache.readFrame(yuvFrame.data())) return false;
+    } else if (format == PixelFormat::Yuv420) {
+        if (std::fread(yuvFrame.data(), 1, frameBytes, pipe) != frameBytes) return false;
+    } else {
+        if (!rgba || std::fread(rgba, 1, frameBytes, pipe) != frameBytes) return false;
+        if (readSampler) readSampler->add(timer.getElapsedTime().asMicroseconds() / 1000.0);
+        return true;
+    }
+    if (readSampler) readSampler->add(timer.restart().asMicroseconds() / 1000.0);
+    if (recorder.isRecording()) recorder.addFrame(yuvFrame.data());
+    if (rgba) {
+        timer.restart();
+        yuv::convertToRgba(yuvFrame.data(), width, height, rgba);
+        if (convertSampler) convertSampler->add(timer.getElapsedTime().asMicroseconds() / 1000.0);
+    }
+    return true;
+}
+
+void VideoPipeReader::Stream::run() {
+    if (!recordPath.empty()) {
+        // The hash reads the whole source once; it is what lets a touched-but-unchanged file keep its cache
+        if (const auto key = IntroCache::keyFor(sourcePath, true)) {
+            recorder.beginRecording(recordPath, *key, width, height, fps);
+        }
+    }
+
+    bool ended = false;
+    for (;;) {
+        std::size_t slot = RING_FRAMES;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            slotFreed.wait(lock, [this] { return stop || draining || !freeSlots.empty(); });
+            if (stop) break;
+            if (!draining) {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+        }
+
+        // The only blocking call, made without the lock held
+        const bool read = readFrame(slot < RING_FRAMES ? slots[slot].data() : nullptr);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!read || stop) {
+            if (slot < RING_FRAMES) freeSlots.push_back(slot);
+            endOfStream = true;
+            ended = !read;
+            break;
+        }
+        if (slot < RING_FRAMES) ready.push_back({slot, nextFrameNumber++});
+    }
+
+    // Only a stream read to its end makes a complete cache
+    if (ended) {
+        recorder.finishRecording();
+    } else {
+        recorder.abortRecording();
+    }
+    if (pipe) {
+        PCLOSE(pipe);
+        pipe = nullptr;
+    }
+    // An intro is shorter than the samplers' print interval
+    if (readSampler) readSampler->flush();
+    if (convertSampler) convertSampler->flush();
+}
+
+const std::uint8_t* VideoPipeReader::frameAt(double seconds, bool& changed) {
+    changed = false;
+    if (!stream_) return nullptr;
+    Stream& s = *stream_;
+    const double due = std::floor(std::max(0.0, seconds) * s.fps);
+    bool freed = false;
+
+    std::unique_lock<std::mutex> lock(s.mutex);
+    // Take the newest frame that is due; anything older than it was never shown
+    std::optional<Frame> next;
+    while (!s.ready.empty() && static_cast<double>(s.ready.front().number) <= due) {
+        if (next) {
+            s.freeSlots.push_back(next->slot);
+            ++s.stats.dropped;
+            freed = true;
+        }
+        next = s.ready.front();
+        s.ready.pop_front();
+    }
+
+    if (next) {
+        if (s.current) {
+            s.freeSlots.push_back(s.current->slot);
+            freed = true;
+        }
+        s.current = next;
+        changed = true;
+        s.stalled = false;
+        ++s.stats.shown;
+    } else if (s.current && static_cast<double>(s.current->number) < due) {
+        // Behind the clock with nothing newer decoded: keep showing the current frame
+        ++s.stats.repeated;
+        if (s.ready.empty() && !s.endOfStream && !s.stalled) {
+            ++s.stats.stalls;
+            s.stalled = true;
+        }
+    }
+
+    const std::uint8_t* pixels = s.current ? s.slots[s.current->slot].data() : nullptr;
+    lock.unlock();
+    if (freed) s.slotFreed.notify_one();
+    return pixels;
+}
+
+bool VideoPipeReader::isFinished(double seconds) {
+    if (!stream_) return true;
+    std::lock_guard<std::mutex> lock(stream_->mutex);
+    if (!stream_->endOfStream || !stream_->ready.empty()) return false;
+    return !stream_->current || seconds * stream_->fps >= static_cast<double>(stream_->current->number + 1);
+}
+
+VideoPipeReader::Stats VideoPipeReader::stats() {
+    if (!stream_) return Stats();
+    std::lock_guard<std::mutex> lock(stream_->mutex);
+    return stream_->stats;
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include "IntroCache.hpp"
+#include "PerfStats.hpp"
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Reads raw frames from an ffmpeg pipe on its own thread into a small ring
+ * of RGBA frame buffers, so a slow pipe never blocks the render thread.
+ * Frames can come down the pipe as yuv420p (1.5 bytes per pixel instead of
+ * 4) and are converted to RGBA on the reader thread. A yuv420p stream can be
+ * recorded into an IntroCache, and a cache can be played back the same way
+ * with no ffmpeg at all.
+ *
+ * The render thread asks for the frame belonging to a point in time (the
+ * audio clock): frames that are already late are dropped, and if the next
+ * frame hasn't arrived yet the current one stays up (a repeat, counted as a
+ * pipe stall when the ring has run dry).
+ *
+ * With PSPV2_PERF=1 the read and the RGBA conversion of each frame are
+ * timed separately, so the rgba and yuv420p pipes can be compared.
+ *
+ * Closing or reopening never waits for the old stream: its thread is told
+ * to stop and left to finish its last read and close the pipe on its own.
+ */
+class VideoPipeReader {
+public:
+    static constexpr std::size_t RING_FRAMES = 4; // One on screen, up to three decoded ahead
+
+    enum class PixelFormat {
+        Rgba,   // -pix_fmt rgba
+        Yuv420  // -pix_fmt yuv420p, BT.601 limited range
+    };
+
+    struct Stats {
+        unsigned int shown = 0;    // Frames uploaded
+        unsigned int dropped = 0;  // Frames decoded but late, skipped
+        unsigned int repeated = 0; // Render frames that kept a frame past its time
+        unsigned int stalls = 0;   // Times the ring was empty when a new frame was due
+    };
+
+    VideoPipeReader() = default;
+    VideoPipeReader(const VideoPipeReader&) = delete;
+    VideoPipeReader& operator=(const VideoPipeReader&) = delete;
+    ~VideoPipeReader();
+
+    // Starts `command`, which must write frames of `format` to stdout, and the reader thread.
+    // With a yuv420p stream and a `recordPath`, the frames are also saved as an IntroCache of `sourcePath`.
+    bool open(const std::string& command, unsigned int width, unsigned int height, float fps,
+              PixelFormat format = PixelFormat::Rgba,
+              const std::string& recordPath = "", const std::string& sourcePath = "");
+    // Plays a recorded IntroCache instead of a pipe; false if it wasn't recorded at width x height
+    bool openCache(const std::string& cachePath, unsigned int width, unsigned int height);
+    // Stops playback without waiting. A recording in progress carries on in the background until the stream ends.
+    void close();
+    bool isOpen() const { return active_; }
+
+    // Frame that should be on screen `seconds` into the video, or nullptr until the first arrives.
+    // `changed` is set when it differs from the previous call's frame and needs uploading.
+    const std::uint8_t* frameAt(double seconds, bool& changed);
+
+    // The stream has ended and its last frame has been on screen for its full duration at `seconds`
+    bool isFinished(double seconds);
+
+    Stats stats();
+
+private:
+    struct Frame {
+        std::size_t slot;
+        std::uint64_t number;
+    };
+
+    // Everything the reader thread touches. The thread holds its own reference,
+    // so a stream that was let go stays valid until its last read returns.
+    struct Stream {
+        FILE* pipe = nullptr;      // Owned by the reader thread once it starts
+        IntroCache cache;          // Playback source when there is no pipe
+        IntroCache recorder;
+        std::string recordPath;
+        std::string sourcePath;
+        PixelFormat format = PixelFormat::Rgba;
+        unsigned int width = 0;
+        unsigned int height = 0;
+        std::size_t frameBytes = 0;         // Per frame on the pipe
+        std::vector<std::uint8_t> yuvFrame; // Reader thread only
+        float fps = 30.f;
+
+        std::mutex mutex;
+        std::condition_variable slotFreed;
+        std::array<std::vector<std::uint8_t>, RING_FRAMES> slots;
+        std::vector<std::size_t> freeSlots;
+        std::deque<Frame> ready;       // Decoded, in presentation order
+        std::optional<Frame> current;  // On screen; its slot isn't reused until replaced
+        std::uint64_t nextFrameNumber = 0;
+        bool endOfStream = false;
+        bool stop = false;
+        bool draining = false;     // Playback closed; only the recording still reads the pipe
+        bool stalled = false;
+        Stats stats;
+
+        // Reader thread only; present while PSPV2_PERF=1
+        std::optional<perf::Sampler> readSampler;
+        std::optional<perf::Sampler> convertSampler;
+
+        void run();
+        bool readFrame(std::uint8_t* rgba); // Null `rgba` reads (and records) without converting
+    };
+
+    void startThread(std::shared_ptr<Stream> stream, unsigned int width, unsigned int height, float fps,
+                     std::size_t frameBytes);
+    // Stops the current stream (unless it is draining a recording) and detaches its thread
+    void release();
+
+    bool active_ = false;
+    std::shared_ptr<Stream> stream_;
+    std::thread thread_;
+};
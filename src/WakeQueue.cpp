@@ -0,0 +1,32 @@
+#include "WakeQueue.hpp"
+
+void WakeQueue::post(WakeReason reason) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reasons_.push_back(reason);
+    }
+    cv_.notify_one();
+}
+
+std::optional<WakeReason> WakeQueue::waitFor(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!cv_.wait_for(lock, timeout, [this] { return !reasons_.empty(); })) {
+        return std::nullopt;
+    }
+    WakeReason reason = reasons_.front();
+    reasons_.pop_front();
+    return reason;
+}
+
+std::optional<WakeReason> WakeQueue::tryPop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (reasons_.empty()) return std::nullopt;
+    WakeReason reason = reasons_.front();
+    reasons_.pop_front();
+    return reason;
+}
+
+void WakeQueue::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    reasons_.clear();
+}
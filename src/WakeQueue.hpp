@@ -0,0 +1,37 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+/**
+ * Reasons the launcher wakes up while it sits in background mode.
+ */
+enum class WakeReason {
+    ProcessExited, // The emulator is gone; bring the menu back
+    Hotkey         // Quick-menu chord pressed during gameplay
+};
+
+/**
+ * Thread-safe mailbox the main thread sleeps on while the emulator runs.
+ * Watchers on other threads post wake reasons; the main thread blocks in
+ * waitFor() instead of spinning a render loop.
+ */
+class WakeQueue {
+public:
+    void post(WakeReason reason);
+
+    // Blocks up to `timeout` for the next reason; empty on timeout
+    std::optional<WakeReason> waitFor(std::chrono::milliseconds timeout);
+
+    // Non-blocking variant of waitFor()
+    std::optional<WakeReason> tryPop();
+
+    void clear();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<WakeReason> reasons_;
+};
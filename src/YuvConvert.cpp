@@ -0,0 +1,186 @@
+#include "YuvConvert.hpp"
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define YUV_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define YUV_NEON 1
+#endif
+
+namespace yuv {
+
+namespace {
+
+// Fixed point, shared by every kernel so they agree to the bit:
+//   luma  = (Y << 8) * 19077 >> 16 - 1192    ~ (Y - 16) * 1.164 * 64
+//   R = luma + 102 * (V - 128)
+//   G = luma -  25 * (U - 128) - 52 * (V - 128)
+//   B = luma + 129 * (U - 128)
+// with 16-bit saturating adds, then (x + 32) >> 6 clamped to 0..255.
+constexpr int LUMA_SCALE = 19077;
+constexpr int LUMA_BIAS = 1192; // 16 * 19077 / 256
+constexpr int V_TO_R = 102;
+constexpr int U_TO_G = 25;
+constexpr int V_TO_G = 52;
+constexpr int U_TO_B = 129;
+
+inline int saturate16(int value) {
+    return std::clamp(value, -32768, 32767);
+}
+
+inline std::uint8_t toByte(int value) {
+    return static_cast<std::uint8_t>(std::clamp(saturate16(value + 32) >> 6, 0, 255));
+}
+
+// Scalar conversion of pixels [x, width) of one row
+void convertRowScalar(const std::uint8_t* yRow, const std::uint8_t* uRow, const std::uint8_t* vRow,
+                      unsigned int x, unsigned int width, std::uint8_t* out) {
+    for (; x < width; ++x) {
+        const int luma = static_cast<int>((static_cast<std::uint32_t>(yRow[x]) << 8) * LUMA_SCALE >> 16) - LUMA_BIAS;
+        const int u = uRow[x / 2] - 128;
+        const int v = vRow[x / 2] - 128;
+        std::uint8_t* pixel = out + x * 4;
+        pixel[0] = toByte(saturate16(luma + V_TO_R * v));
+        pixel[1] = toByte(saturate16(saturate16(luma - U_TO_G * u) - V_TO_G * v));
+        pixel[2] = toByte(saturate16(luma + U_TO_B * u));
+        pixel[3] = 255;
+    }
+}
+
+#if defined(YUV_SSE2)
+
+// 16 pixels per iteration; the scalar loop finishes widths that aren't a multiple of 16
+void convertRow(const std::uint8_t* yRow, const std::uint8_t* uRow, const std::uint8_t* vRow,
+                unsigned int width, std::uint8_t* out) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lumaBias = _mm_set1_epi16(LUMA_BIAS);
+    const __m128i chromaOffset = _mm_set1_epi16(128);
+    const __m128i lumaScale = _mm_set1_epi16(static_cast<short>(LUMA_SCALE));
+    const __m128i vToR = _mm_set1_epi16(V_TO_R);
+    const __m128i uToG = _mm_set1_epi16(U_TO_G);
+    const __m128i vToG = _mm_set1_epi16(V_TO_G);
+    const __m128i uToB = _mm_set1_epi16(U_TO_B);
+    const __m128i rounding = _mm_set1_epi16(32);
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+
+    auto channel = [&](__m128i lo, __m128i hi) {
+        lo = _mm_srai_epi16(_mm_adds_epi16(lo, rounding), 6);
+        hi = _mm_srai_epi16(_mm_adds_epi16(hi, rounding), 6);
+        return _mm_packus_epi16(lo, hi);
+    };
+
+    unsigned int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow + x));
+        // Each chroma sample covers two pixels of the row
+        __m128i u = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(uRow + x / 2));
+        __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(vRow + x / 2));
+        u = _mm_unpacklo_epi8(u, u);
+        v = _mm_unpacklo_epi8(v, v);
+
+        const __m128i lumaLo = _mm_sub_epi16(_mm_mulhi_epu16(_mm_unpacklo_epi8(zero, y), lumaScale), lumaBias);
+        const __m128i lumaHi = _mm_sub_epi16(_mm_mulhi_epu16(_mm_unpackhi_epi8(zero, y), lumaScale), lumaBias);
+        const __m128i uLo = _mm_sub_epi16(_mm_unpacklo_epi8(u, zero), chromaOffset);
+        const __m128i uHi = _mm_sub_epi16(_mm_unpackhi_epi8(u, zero), chromaOffset);
+        const __m128i vLo = _mm_sub_epi16(_mm_unpacklo_epi8(v, zero), chromaOffset);
+        const __m128i vHi = _mm_sub_epi16(_mm_unpackhi_epi8(v, zero), chromaOffset);
+
+        const __m128i r = channel(_mm_adds_epi16(lumaLo, _mm_mullo_epi16(vLo, vToR)),
+                                  _mm_adds_epi16(lumaHi, _mm_mullo_epi16(vHi, vToR)));
+        const __m128i g = channel(_mm_subs_epi16(_mm_subs_epi16(lumaLo, _mm_mullo_epi16(uLo, uToG)), _mm_mullo_epi16(vLo, vToG)),
+                                  _mm_subs_epi16(_mm_subs_epi16(lumaHi, _mm_mullo_epi16(uHi, uToG)), _mm_mullo_epi16(vHi, vToG)));
+        const __m128i b = channel(_mm_adds_epi16(lumaLo, _mm_mullo_epi16(uLo, uToB)),
+                                  _mm_adds_epi16(lumaHi, _mm_mullo_epi16(uHi, uToB)));
+
+        // Interleave to RGBA
+        const __m128i rgLo = _mm_unpacklo_epi8(r, g);
+        const __m128i rgHi = _mm_unpackhi_epi8(r, g);
+        const __m128i baLo = _mm_unpacklo_epi8(b, alpha);
+        const __m128i baHi = _mm_unpackhi_epi8(b, alpha);
+        __m128i* dst = reinterpret_cast<__m128i*>(out + x * 4);
+        _mm_storeu_si128(dst + 0, _mm_unpacklo_epi16(rgLo, baLo));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(rgLo, baLo));
+        _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(rgHi, baHi));
+        _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(rgHi, baHi));
+    }
+    convertRowScalar(yRow, uRow, vRow, x, width, out);
+}
+
+#elif defined(YUV_NEON)
+
+inline int16x8_t lumaTerm(uint8x8_t y) {
+    // (Y << 8) * LUMA_SCALE >> 16 as an unsigned high multiply, then the bias
+    const uint16x8_t shifted = vshll_n_u8(y, 8);
+    const uint32x4_t lo = vmull_n_u16(vget_low_u16(shifted), LUMA_SCALE);
+    const uint32x4_t hi = vmull_n_u16(vget_high_u16(shifted), LUMA_SCALE);
+    const int16x8_t scaled = vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16)));
+    return vsubq_s16(scaled, vdupq_n_s16(LUMA_BIAS));
+}
+
+inline uint8x8_t channel(int16x8_t value) {
+    return vqmovun_s16(vshrq_n_s16(vqaddq_s16(value, vdupq_n_s16(32)), 6));
+}
+
+void convertRow(const std::uint8_t* yRow, const std::uint8_t* uRow, const std::uint8_t* vRow,
+                unsigned int width, std::uint8_t* out) {
+    unsigned int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16_t y = vld1q_u8(yRow + x);
+        const uint8x8x2_t u = vzip_u8(vld1_u8(uRow + x / 2), vld1_u8(uRow + x / 2));
+        const uint8x8x2_t v = vzip_u8(vld1_u8(vRow + x / 2), vld1_u8(vRow + x / 2));
+
+        uint8x16x4_t rgba;
+        rgba.val[3] = vdupq_n_u8(255);
+        uint8x8_t r[2], g[2], b[2];
+        for (int half = 0; half < 2; ++half) {
+            const int16x8_t luma = lumaTerm(half == 0 ? vget_low_u8(y) : vget_high_u8(y));
+            const int16x8_t uc = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u.val[half])), vdupq_n_s16(128));
+            const int16x8_t vc = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v.val[half])), vdupq_n_s16(128));
+            r[half] = channel(vqaddq_s16(luma, vmulq_n_s16(vc, V_TO_R)));
+            g[half] = channel(vqsubq_s16(vqsubq_s16(luma, vmulq_n_s16(uc, U_TO_G)), vmulq_n_s16(vc, V_TO_G)));
+            b[half] = channel(vqaddq_s16(luma, vmulq_n_s16(uc, U_TO_B)));
+        }
+        rgba.val[0] = vcombine_u8(r[0], r[1]);
+        rgba.val[1] = vcombine_u8(g[0], g[1]);
+        rgba.val[2] = vcombine_u8(b[0], b[1]);
+        vst4q_u8(out + x * 4, rgba);
+    }
+    convertRowScalar(yRow, uRow, vRow, x, width, out);
+}
+
+#else
+
+void convertRow(const std::uint8_t* yRow, const std::uint8_t* uRow, const std::uint8_t* vRow,
+                unsigned int width, std::uint8_t* out) {
+    convertRowScalar(yRow, uRow, vRow, 0, width, out);
+}
+
+#endif
+
+} // namespace
+
+void convertToRgba(const std::uint8_t* planes, unsigned int width, unsigned int height, std::uint8_t* rgba) {
+    const std::uint8_t* yPlane = planes;
+    const std::uint8_t* uPlane = yPlane + static_cast<std::size_t>(width) * height;
+    const std::uint8_t* vPlane = uPlane + static_cast<std::size_t>(width / 2) * (height / 2);
+    for (unsigned int line = 0; line < height; ++line) {
+        const std::size_t chromaOffset = static_cast<std::size_t>(line / 2) * (width / 2);
+        convertRow(yPlane + static_cast<std::size_t>(line) * width, uPlane + chromaOffset, vPlane + chromaOffset,
+                   width, rgba + static_cast<std::size_t>(line) * width * 4);
+    }
+}
+
+const char* kernelName() {
+#if defined(YUV_SSE2)
+    return "SSE2";
+#elif defined(YUV_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace yuv
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Planar YUV 4:2:0 (BT.601, limited range) to RGBA conversion for the intro
+ * video pipe. Uses SSE2 on x86-64 and NEON on ARM64 (both baseline, so no
+ * runtime dispatch), with a scalar fallback that gives bit-identical output.
+ */
+namespace yuv {
+
+// `planes` is one ffmpeg yuv420p frame: width*height Y, then (width/2)*(height/2) U, then V.
+// Width and height must be even; `rgba` receives width*height*4 bytes.
+void convertToRgba(const std::uint8_t* planes, unsigned int width, unsigned int height, std::uint8_t* rgba);
+
+// Name of the kernel convertToRgba() uses, for logs
+const char* kernelName();
+
+} // namespace yuv
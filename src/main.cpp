@@ -11,12 +11,20 @@
 #include "AboutScreen.hpp"
 #include "UiSoundBank.hpp"
 #include "QuickMenu.hpp"
+#include "BackdropLayer.hpp"
+#include "WakeQueue.hpp"
+#include "ProcessSupervisor.hpp"
+#include "RomPrefetcher.hpp"
+#include "InputMonitor.hpp"
+#include "PlayHistory.hpp"
+#include "PerfStats.hpp"
 #include <nlohmann/json.hpp>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <chrono>
+#include <algorithm>
 #include <windows.h>
-#include <psapi.h>
-#include <tlhelp32.h>
 
 using json = nlohmann::json;
 
@@ -34,12 +42,14 @@ enum class AppState {
 int main() {
   // Load settings for fullscreen mode
   bool fullscreen = true;  // Default to fullscreen
+  bool idleRendering = true; // Stop redrawing while nothing on screen changes
   std::ifstream settingsFile("config/settings.json");
   if (settingsFile) {
     try {
       json settingsJson;
       settingsFile >> settingsJson;
       fullscreen = settingsJson.value("fullscreen", true);
+      idleRendering = settingsJson.value("idle_rendering", true);
     } catch (...) {
       // Use default if parsing fails
     }
@@ -74,51 +84,86 @@ int main() {
 
   SetupScreen setupScreen(sounds, userProfile);
   IntroScreen intro(sounds, "assets/images/psp_logo.png");
-  GameStartupScreen gameStartup("assets/images/PSP-STARTUP.png", 
+  GameStartupScreen gameStartup("assets/images/play playstation GIF.gif", 
                                 "assets/Sounds/Program start.mp3");
   ControllerSelectScreen controllerSelect(sounds);
   ThemeSelector themeSelector(sounds, userProfile);
   CustomThemeCreator themeCreator(sounds);
   AboutScreen aboutScreen(sounds);
 
-  Menu menu("config/menu.json", sounds, &userProfile);
+  // Last played / play time per game, for the Games sort orders
+  PlayHistory playHistory;
+  const std::string playHistoryPath = "config/play_history.json";
+  playHistory.load(playHistoryPath);
+
+  Menu menu("config/menu.json", sounds, &userProfile, &playHistory);
+  const std::string uiStatePath = "config/ui_state.json";
+  menu.restoreUiState(uiStatePath);
   Launcher launcher("config/settings.json");
   MenuItem pendingLaunchItem;
   ControllerSelectScreen::InputMethod selectedInputMethod;
   
   QuickMenu quickMenu(sounds);
 
+  // Overlays draw over a snapshot of the menu taken when they open, not a live menu
+  BackdropLayer menuBackdrop;
+  auto drawMenuBackdrop = [&]() {
+    if (!menuBackdrop.isValid(window)) {
+      menuBackdrop.capture(window, [&](sf::RenderTarget& target) { menu.draw(target); });
+    }
+    menuBackdrop.draw(window);
+  };
+
   sf::Clock clock;
   
-  // Function to check if PPSSPP is running
-  auto isPPSSPPRunning = []() -> bool {
-    DWORD processes[1024], needed, processCount;
-    if (!EnumProcesses(processes, sizeof(processes), &needed)) {
-      return false;
+  // Emulator exit is reported by the OS through the supervisor; nothing is polled per frame
+  WakeQueue wakeQueue;
+  ProcessSupervisor emulator(wakeQueue);
+
+  // PSPV2_PERF=1: Enter -> spawn -> first PPSSPP window, per launch
+  LaunchLatencyProbe launchProbe;
+  std::chrono::steady_clock::time_point launchRequestedAt = std::chrono::steady_clock::now();
+
+  // Launch is pipelined: the ROM is read ahead from the moment a game is picked, and with
+  // "early_launch" PPSSPP starts minimized while the startup animation plays
+  RomPrefetcher romPrefetcher;
+  std::optional<ProcessId> earlyEmulatorPid;
+  bool emulatorLaunched = false;
+
+  auto launchEmulator = [&](bool useController, bool startMinimized) {
+    const auto spawnStarted = std::chrono::steady_clock::now();
+    std::optional<SpawnedProcess> spawned = launcher.launchItem(pendingLaunchItem, useController, startMinimized);
+    const auto spawnFinished = std::chrono::steady_clock::now();
+    emulatorLaunched = true;
+
+    std::optional<ProcessId> emulatorPid;
+    if (spawned) {
+      emulatorPid = spawned->pid;
+      emulator.adopt(*spawned);
+      playHistory.beginSession(pendingLaunchItem.path);
+      playHistory.save(playHistoryPath);
     }
-    processCount = needed / sizeof(DWORD);
-    
-    for (unsigned int i = 0; i < processCount; i++) {
-      if (processes[i] != 0) {
-        HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, processes[i]);
-        if (hProcess) {
-          char processName[MAX_PATH] = {0};
-          HMODULE hMod;
-          DWORD cbNeeded;
-          
-          if (EnumProcessModules(hProcess, &hMod, sizeof(hMod), &cbNeeded)) {
-            GetModuleBaseNameA(hProcess, hMod, processName, sizeof(processName));
-            std::string name(processName);
-            if (name.find("PPSSPP") != std::string::npos) {
-              CloseHandle(hProcess);
-              return true;
-            }
-          }
-          CloseHandle(hProcess);
-        }
-      }
+    if (perf::enabled()) {
+      launchProbe.start(emulatorPid, launcher.emulatorProcessName(), launchRequestedAt, spawnStarted, spawnFinished);
+    }
+    return emulatorPid;
+  };
+
+  // Closes the play-history session of the game that just exited and persists it
+  auto endPlaySession = [&]() {
+    if (!playHistory.inSession()) return;
+    playHistory.endSession();
+    playHistory.save(playHistoryPath);
+  };
+
+  // Restores the minimized early-launched window once the animation is over
+  auto revealEarlyEmulator = [&]() {
+    if (!earlyEmulatorPid || !revealProcessWindow(*earlyEmulatorPid)) return;
+    earlyEmulatorPid.reset();
+    if (perf::enabled()) {
+      const auto elapsed = std::chrono::steady_clock::now() - launchRequestedAt;
+      std::cout << "[Launch] Enter -> reveal: " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms\n";
     }
-    return false;
   };
   
   // Function to find PPSSPP window handle
@@ -145,101 +190,211 @@ int main() {
       PostMessage(ppssppWindow, WM_KEYUP, VK_F12, 0);
     }
   };
-  
-  // Function to terminate PPSSPP process
-  auto terminatePPSSPP = []() -> void {
-    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (hSnapshot == INVALID_HANDLE_VALUE) return;
-    
-    PROCESSENTRY32 pe32;
-    pe32.dwSize = sizeof(PROCESSENTRY32);
-    
-    if (Process32First(hSnapshot, &pe32)) {
-      do {
-        std::string processName(pe32.szExeFile);
-        if (processName.find("PPSSPP") != std::string::npos) {
-          HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, FALSE, pe32.th32ProcessID);
-          if (hProcess) {
-            TerminateProcess(hProcess, 0);
-            CloseHandle(hProcess);
-          }
-        }
-      } while (Process32Next(hSnapshot, &pe32));
+
+  // Touchpad button (button 13 on PS5 controller) or Escape key
+  auto isQuickMenuHotkey = [](const sf::Event& event) -> bool {
+    if (const auto* buttonPressed = event.getIf<sf::Event::JoystickButtonPressed>()) {
+      return buttonPressed->button == 13;
+    }
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+      return keyPressed->code == sf::Keyboard::Key::Escape;
+    }
+    return false;
+  };
+
+  auto showQuickMenu = [&]() {
+    sounds.playSystemOk();
+    pausePPSSPP(); // Pause the emulator
+    window.setVisible(true);
+    window.requestFocus();
+    quickMenu.show();
+  };
+
+  // Background mode: while the emulator runs the launcher draws nothing, holds no preview art
+  // and sleeps on the wake queue until the game exits or the quick-menu hotkey is pressed
+  bool backgroundMode = false;
+  sf::Clock backgroundClock;    // Time since entering background mode
+  sf::Clock emulatorPollClock;  // Looks for the emulator until the supervisor has picked it up
+  InputMonitor inputMonitor(wakeQueue); // Reads the hotkey straight from the devices; the hidden window gets no input
+
+  auto enterBackgroundMode = [&]() {
+    backgroundMode = true;
+    backgroundClock.restart();
+    emulatorPollClock.restart();
+    wakeQueue.clear();
+    if (emulator.isSupervising() && !emulator.isRunning()) {
+      // An early-launched emulator may already have quit during the animation
+      wakeQueue.post(WakeReason::ProcessExited);
     }
-    CloseHandle(hSnapshot);
+    window.setVisible(false);
+    menu.saveUiState(uiStatePath);
+    menu.suspend();
+    themeSelector.releaseTextures();
+    menuBackdrop.release();
+    inputMonitor.start(emulator.processId());
+  };
+
+  // Idle-aware rendering: a frame is only drawn when input arrived, the screen reports an
+  // animation, the state changed or the clock's minute rolled over. Otherwise the loop blocks
+  // in waitEvent instead of redrawing the same picture 60 times a second.
+  bool redraw = true;
+  AppState lastState = state;
+  auto lastMinute = std::chrono::duration_cast<std::chrono::minutes>(std::chrono::system_clock::now().time_since_epoch());
+
+  // Time to sleep when idle: until the next minute (for the clock), but at least once a second
+  // so PPSSPP exiting is still noticed
+  auto idleTimeout = []() -> sf::Time {
+    using namespace std::chrono;
+    const auto now = system_clock::now().time_since_epoch();
+    const auto toNextMinute = duration_cast<milliseconds>(duration_cast<minutes>(now) + minutes(1) - now);
+    return sf::milliseconds(static_cast<std::int32_t>(std::min<long long>(1000, toNextMinute.count() + 1)));
+  };
+
+  // PSPV2_PERF=1: frames drawn and whole-process CPU per second, to compare idle cost
+  // (set "idle_rendering": false in settings.json for the old always-60fps loop)
+  auto processCpuSeconds = []() -> double {
+    FILETIME creation, exitTime, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) return 0.0;
+    auto seconds = [](const FILETIME& ft) {
+      return ((static_cast<unsigned long long>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime) * 1e-7;
+    };
+    return seconds(kernel) + seconds(user);
   };
+  perf::Sampler framesSampler("Frames drawn", "per s");
+  perf::Sampler cpuSampler("Process CPU", "%");
+  sf::Clock perfClock;
+  int framesDrawn = 0;
+  double lastCpuSeconds = processCpuSeconds();
 
   while (window.isOpen()) {
+    if (backgroundMode) {
+      // Nothing is rendered here. The input monitor and the supervisor wake us; the timeout only
+      // matters while there is still something to poll for (a shell-launched or unrevealed emulator).
+      // Window events are pumped between waits, which also serves as the hotkey path if the
+      // monitor couldn't start.
+      const bool pollingNeeded = !emulator.isSupervising() || earlyEmulatorPid || !inputMonitor.isRunning();
+      std::optional<WakeReason> wake = wakeQueue.waitFor(std::chrono::milliseconds(pollingNeeded ? 200 : 2000));
+      while (auto event = window.pollEvent()) {
+        if (event->is<sf::Event::Closed>()) {
+          window.close();
+        } else if (isQuickMenuHotkey(*event)) {
+          wakeQueue.post(WakeReason::Hotkey);
+        }
+      }
+
+      if (earlyEmulatorPid) {
+        revealEarlyEmulator();
+        if (backgroundClock.getElapsedTime() >= sf::seconds(10.f)) {
+          earlyEmulatorPid.reset(); // Leave it to the user rather than stealing focus later
+        }
+      }
+
+      // Normally the supervisor already holds the spawned PPSSPP and posts ProcessExited.
+      // Only a shell launch ("launch_via_shell") leaves the PID to be looked up once it appears.
+      if (!emulator.isSupervising() && emulatorPollClock.getElapsedTime() >= sf::milliseconds(500)) {
+        emulatorPollClock.restart();
+        if (auto pid = ProcessSupervisor::findProcessByName(launcher.emulatorProcessName())) {
+          emulator.adopt(*pid);
+          inputMonitor.start(*pid); // Now Escape can be limited to the emulator's window
+        } else if (backgroundClock.getElapsedTime() >= sf::seconds(10.f)) {
+          std::cerr << "PPSSPP did not start; returning to menu\n";
+          wakeQueue.post(WakeReason::ProcessExited);
+        }
+      }
+
+      for (auto reason = wake ? wake : wakeQueue.tryPop(); reason; reason = wakeQueue.tryPop()) {
+        if (!backgroundMode) break; // Already woken by an earlier reason
+        backgroundMode = false;
+        inputMonitor.stop();
+        if (*reason == WakeReason::ProcessExited) {
+          emulator.release();
+          endPlaySession();
+        }
+        menu.resume();
+        state = AppState::Menu;
+        if (*reason == WakeReason::Hotkey) {
+          showQuickMenu();
+        } else {
+          window.setVisible(true);
+          window.requestFocus();
+        }
+        redraw = true;
+        clock.restart(); // Time spent in the background is not animation time
+      }
+      continue;
+    }
+
     // Check if PPSSPP is running to disable input
-    bool ppssppActive = isPPSSPPRunning();
+    bool ppssppActive = emulator.isRunning();
+    bool changed = false;
     
-    while (auto event = window.pollEvent()) {
-      if (event->is<sf::Event::Closed>()) {
+    auto handleEvent = [&](const sf::Event& event) {
+      changed = true;
+      if (event.is<sf::Event::Closed>()) {
         window.close();
       }
       
-      // Always check for Touchpad button or Escape key to trigger quick menu during PPSSPP gameplay
-      if (ppssppActive && !quickMenu.isVisible()) {
-        // Check for Touchpad button (button 13 on PS5 controller) or Escape key
-        if (const auto* buttonPressed = event->getIf<sf::Event::JoystickButtonPressed>()) {
-          if (buttonPressed->button == 13) { // Touchpad button
-            sounds.playSystemOk();
-            pausePPSSPP(); // Pause the emulator
-            window.setVisible(true);
-            window.requestFocus();
-            quickMenu.show();
-          }
-        }
-        else if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-          if (keyPressed->code == sf::Keyboard::Key::Escape) {
-            sounds.playSystemOk();
-            pausePPSSPP(); // Pause the emulator
-            window.setVisible(true);
-            window.requestFocus();
-            quickMenu.show();
-          }
-        }
+      // Always check for Touchpad button or Escape key to trigger quick menu during PPSSPP gameplay.
+      // An early-launched emulator is already running under the startup animation; it isn't gameplay until revealed.
+      if (ppssppActive && state != AppState::GameStartup && !quickMenu.isVisible() && isQuickMenuHotkey(event)) {
+        showQuickMenu();
       }
       
       // Handle quick menu input when visible
       if (quickMenu.isVisible()) {
-        quickMenu.handleEvent(*event);
+        quickMenu.handleEvent(event);
       }
       // Only process input if PPSSPP is not running and quick menu not visible
       else if (!ppssppActive) {
         if (state == AppState::Setup) {
-          setupScreen.handleEvent(*event);
+          setupScreen.handleEvent(event);
         } else if (state == AppState::Intro) {
-          intro.handleEvent(*event);
+          intro.handleEvent(event);
         } else if (state == AppState::Menu) {
-          menu.handleEvent(*event);
+          menu.handleEvent(event);
         } else if (state == AppState::ControllerSelect) {
-          controllerSelect.handleEvent(*event);
+          controllerSelect.handleEvent(event);
         } else if (state == AppState::ThemeSelect) {
-          themeSelector.handleEvent(*event);
+          themeSelector.handleEvent(event);
         } else if (state == AppState::ThemeCreator) {
-          themeCreator.handleEvent(*event);
+          themeCreator.handleEvent(event);
         } else if (state == AppState::About) {
-          aboutScreen.handleEvent(*event);
+          aboutScreen.handleEvent(event);
         }
         // No input handling during GameStartup state
       }
+    };
+
+    if (!redraw && idleRendering) {
+      // Nothing is animating: sleep until input or the next timed check
+      if (auto event = window.waitEvent(idleTimeout())) {
+        handleEvent(*event);
+      }
+      clock.restart(); // Time spent asleep is not animation time
+    }
+    while (auto event = window.pollEvent()) {
+      handleEvent(*event);
     }
 
     float dt = clock.restart().asSeconds();
     
     // Handle quick menu choice
     if (quickMenu.getChoice() == QuickMenu::Choice::ReturnToMenu) {
-      terminatePPSSPP();
+      changed = true;
+      emulator.terminate(); // Only the PPSSPP we launched
+      emulator.release();
+      endPlaySession();
       quickMenu.reset();
       window.setVisible(true);
       window.requestFocus();
       state = AppState::Menu;
     }
     else if (quickMenu.getChoice() == QuickMenu::Choice::ResumeGame) {
+      changed = true;
       unpausePPSSPP(); // Unpause the emulator
       quickMenu.reset();
-      window.setVisible(false);
+      enterBackgroundMode();
+      continue;
     }
     
     // Update quick menu
@@ -268,14 +423,14 @@ int main() {
         
         // Check if user wants to exit
         if (pendingLaunchItem.type == "exit_app") {
-          menu.stopPreviewAudio();
+          menu.stopPreviewPlayback();
           sounds.playSystemOk();
           window.close();
           menu.resetLaunchRequest();
         }
         // Check if user wants factory reset
         else if (pendingLaunchItem.type == "factory_reset") {
-          menu.stopPreviewAudio();
+          menu.stopPreviewPlayback();
           sounds.playSystemOk();
           userProfile.factoryReset();
           userProfile.save("config/user_profile.json");
@@ -284,7 +439,7 @@ int main() {
         }
         // Check if user wants to change theme
         else if (pendingLaunchItem.type == "theme_select") {
-          menu.stopPreviewAudio();
+          menu.stopPreviewPlayback();
           sounds.playSystemOk();
           state = AppState::ThemeSelect;
           themeSelector.reset();
@@ -292,7 +447,7 @@ int main() {
         }
         // Check if user wants to create custom theme
         else if (pendingLaunchItem.type == "theme_creator") {
-          menu.stopPreviewAudio();
+          menu.stopPreviewPlayback();
           sounds.playSystemOk();
           state = AppState::ThemeCreator;
           themeCreator.reset();
@@ -307,7 +462,7 @@ int main() {
         }
         // Check if user wants to see About screen
         else if (pendingLaunchItem.type == "about") {
-          menu.stopPreviewAudio();
+          menu.stopPreviewPlayback();
           sounds.playSystemOk();
           state = AppState::About;
           aboutScreen.reset();
@@ -315,7 +470,11 @@ int main() {
         }
         // Only show startup screen and controller select for PSP games
         else if (pendingLaunchItem.type == "psp_iso" || pendingLaunchItem.type == "psp_eboot") {
-          menu.stopPreviewAudio();
+          launchRequestedAt = std::chrono::steady_clock::now();
+          emulatorLaunched = false;
+          earlyEmulatorPid.reset();
+          romPrefetcher.start(launcher.gamePathFor(pendingLaunchItem), launcher.romPrefetchBytes());
+          menu.stopPreviewPlayback();
           sounds.playSystemOk(); // Play "OK" sound before controller select
           
           // Transition to ControllerSelect state
@@ -325,7 +484,7 @@ int main() {
         }
         // For everything else, launch directly
         else {
-          menu.stopPreviewAudio();
+          menu.stopPreviewPlayback();
           sounds.playSystemOk();
           launcher.launchItem(pendingLaunchItem, false);
           menu.resetLaunchRequest();
@@ -344,6 +503,11 @@ int main() {
         // Transition to GameStartup state
         state = AppState::GameStartup;
         gameStartup.start();
+        
+        if (launcher.earlyLaunch()) {
+          bool useController = (selectedInputMethod == ControllerSelectScreen::InputMethod::PS5Controller);
+          earlyEmulatorPid = launchEmulator(useController, true);
+        }
       }
     } else if (state == AppState::GameStartup) {
       gameStartup.update(dt);
@@ -351,16 +515,16 @@ int main() {
         // Launch the game after startup animation with selected input method
         bool useController = (selectedInputMethod == ControllerSelectScreen::InputMethod::PS5Controller);
         
-        // Minimize the window before launching the game
-        window.setVisible(false);
-        
-        launcher.launchItem(pendingLaunchItem, useController);
-        
-        // Restore window visibility after game closes
-        window.setVisible(true);
-        window.requestFocus();
+        if (!emulatorLaunched) {
+          launchEmulator(useController, false);
+        } else {
+          revealEarlyEmulator(); // Retried from background mode if its window isn't up yet
+        }
         
-        state = AppState::Menu; // Return to menu
+        // Hide and go quiet until the game closes; the menu comes back from there
+        state = AppState::Menu;
+        enterBackgroundMode();
+        continue;
       }
     } else if (state == AppState::ThemeSelect) {
       themeSelector.update(dt);
@@ -378,10 +542,16 @@ int main() {
       themeCreator.update(dt);
       if (themeCreator.isFinished()) {
         if (!themeCreator.wasCancelled()) {
-          // TODO: Apply created theme
+          // The menu shows the creator's rendered background as is, without rendering it again
           auto theme = themeCreator.getCreatedTheme();
           if (theme.has_value()) {
             std::cout << "Custom theme created: " << theme->name << "\n";
+            menu.setCustomBackground(themeCreator.backgroundTexture());
+            // Selecting the saved bundle makes the next start load it in one read
+            if (!themeCreator.savedThemePath().empty()) {
+              userProfile.setTheme(std::filesystem::path(themeCreator.savedThemePath()).filename().string());
+              userProfile.save("config/user_profile.json");
+            }
           }
         }
         state = AppState::Menu;
@@ -393,25 +563,65 @@ int main() {
       }
     }
 
+    // Decide whether this frame needs drawing at all
+    bool animating = quickMenu.isVisible() && quickMenu.isAnimating();
+    if (state == AppState::Setup) {
+      animating = animating || setupScreen.isAnimating();
+    } else if (state == AppState::Intro) {
+      animating = animating || intro.isAnimating();
+    } else if (state == AppState::Menu) {
+      animating = animating || menu.isAnimating();
+    } else if (state == AppState::ControllerSelect) {
+      animating = animating || controllerSelect.isAnimating();
+    } else if (state == AppState::GameStartup) {
+      animating = animating || gameStartup.isAnimating();
+    } else if (state == AppState::ThemeSelect) {
+      animating = animating || themeSelector.isAnimating();
+    } else if (state == AppState::ThemeCreator) {
+      animating = animating || themeCreator.isAnimating();
+    } else if (state == AppState::About) {
+      animating = animating || aboutScreen.isAnimating();
+    }
+    const auto minute = std::chrono::duration_cast<std::chrono::minutes>(std::chrono::system_clock::now().time_since_epoch());
+    const bool drawFrame = !idleRendering || redraw || changed || animating || state != lastState || minute != lastMinute;
+    redraw = animating;
+    lastState = state;
+    lastMinute = minute;
+
+    if (perf::enabled() && perfClock.getElapsedTime() >= sf::seconds(1.f)) {
+      const double elapsed = perfClock.restart().asSeconds();
+      const double cpuSeconds = processCpuSeconds();
+      framesSampler.add(framesDrawn / elapsed);
+      cpuSampler.add(100.0 * (cpuSeconds - lastCpuSeconds) / elapsed);
+      lastCpuSeconds = cpuSeconds;
+      framesDrawn = 0;
+    }
+
+    if (!drawFrame || !window.isOpen()) {
+      continue;
+    }
+    ++framesDrawn;
+
     window.clear(sf::Color::Black);
     if (state == AppState::Setup) {
       setupScreen.draw(window);
     } else if (state == AppState::Intro) {
       intro.draw(window);
     } else if (state == AppState::Menu) {
+      menuBackdrop.invalidate(); // The next overlay snapshots the menu as it looks then
       menu.draw(window);
     } else if (state == AppState::ControllerSelect) {
-      menu.draw(window); // Draw menu in background
+      drawMenuBackdrop(); // Draw menu in background
       controllerSelect.draw(window);
     } else if (state == AppState::GameStartup) {
       gameStartup.draw(window);
     } else if (state == AppState::ThemeSelect) {
-      menu.draw(window); // Draw menu in background
+      drawMenuBackdrop(); // Draw menu in background
       themeSelector.draw(window);
     } else if (state == AppState::ThemeCreator) {
       themeCreator.draw(window);
     } else if (state == AppState::About) {
-      menu.draw(window); // Draw menu in background
+      drawMenuBackdrop(); // Draw menu in background
       aboutScreen.draw(window);
     }
     